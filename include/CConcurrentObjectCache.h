@@ -5,6 +5,10 @@
 #ifndef __NBL_C_CONCURRENT_OBJECT_CACHE_H_INCLUDED__
 #define __NBL_C_CONCURRENT_OBJECT_CACHE_H_INCLUDED__
 
+#include <array>
+#include <shared_mutex>
+#include <mutex>
+
 #include "CObjectCache.h"
 #include "nbl/system/SReadWriteSpinLock.h"
 
@@ -141,6 +145,184 @@ namespace impl
             return r;
         }
     };
+
+    //! Drop-in replacement for `CMakeCacheConcurrent` which hash-partitions the keys over `ShardCount` independent caches,
+    //! each with its own reader-writer lock, so that threads working on different keys do not contend at all.
+    /** Lookups of the same shard still proceed in parallel (shared lock), only writers to the same shard serialize.
+    Whole-cache queries (`getSize`, `contains`, `outputAll`, `clear`) visit the shards one after another and are therefore
+    not an atomic snapshot when raced with writers. */
+    template<typename CacheT, uint32_t ShardCount=16u>
+    class CMakeCacheConcurrentSharded
+    {
+        static_assert(ShardCount && (ShardCount&(ShardCount-1u))==0u, "ShardCount must be a power of two!");
+
+        // lets us get at the protected typedefs of the cache
+        struct alignas(64) SShard final : CacheT
+        {
+            using CacheT::CacheT;
+
+            using KeyType_impl = typename CacheT::KeyType_impl;
+            using ValueType_impl = typename CacheT::ValueType_impl;
+            using ImmutableValueType_impl = typename CacheT::ImmutableValueType_impl;
+
+            mutable std::shared_mutex lock;
+        };
+        using K = typename SShard::KeyType_impl;
+        using V = typename SShard::ValueType_impl;
+        using ImmutableV = typename SShard::ImmutableValueType_impl;
+
+    public:
+        using IteratorType = typename CacheT::IteratorType;
+        using ConstIteratorType = typename CacheT::ConstIteratorType;
+        using RevIteratorType = typename CacheT::RevIteratorType;
+        using ConstRevIteratorType = typename CacheT::ConstRevIteratorType;
+        using RangeType = typename CacheT::RangeType;
+        using ConstRangeType = typename CacheT::ConstRangeType;
+        using PairType = typename CacheT::PairType;
+        using MutablePairType = typename CacheT::MutablePairType;
+        using CachedType = typename CacheT::CachedType;
+        using KeyType = typename CacheT::KeyType;
+        using GreetFuncType = typename CacheT::GreetFuncType;
+        using DisposalFuncType = typename CacheT::DisposalFuncType;
+
+        CMakeCacheConcurrentSharded() = default;
+        inline explicit CMakeCacheConcurrentSharded(const GreetFuncType& _greeting, const DisposalFuncType& _disposal)
+            : CMakeCacheConcurrentSharded(_greeting,_disposal,std::make_index_sequence<ShardCount>{}) {}
+
+        inline bool insert(const K& _key, const V& _val)
+        {
+            auto& shard = getShard(_key);
+            std::unique_lock lk(shard.lock);
+            return shard.insert(_key, _val);
+        }
+
+        inline bool contains(ImmutableV& _object) const
+        {
+            for (const auto& shard : m_shards)
+            {
+                std::shared_lock lk(shard.lock);
+                if (shard.contains(_object))
+                    return true;
+            }
+            return false;
+        }
+
+        inline size_t getSize() const
+        {
+            size_t r = 0ull;
+            for (const auto& shard : m_shards)
+            {
+                std::shared_lock lk(shard.lock);
+                r += shard.getSize();
+            }
+            return r;
+        }
+
+        inline void clear()
+        {
+            for (auto& shard : m_shards)
+            {
+                std::unique_lock lk(shard.lock);
+                shard.clear();
+            }
+        }
+
+        //! Returns true if had to insert
+        bool swapObjectValue(const K& _key, const ImmutableV& _obj, const V& _val)
+        {
+            auto& shard = getShard(_key);
+            std::unique_lock lk(shard.lock);
+            return shard.swapObjectValue(_key, _obj, _val);
+        }
+
+        bool getAndStoreKeyRangeOrReserve(const K& _key, size_t& _inOutStorageSize, V* _out, bool* _gotAll)
+        {
+            auto& shard = getShard(_key);
+            std::unique_lock lk(shard.lock);
+            return shard.getAndStoreKeyRangeOrReserve(_key, _inOutStorageSize, _out, _gotAll);
+        }
+
+        inline bool removeObject(const V& _obj, const K& _key)
+        {
+            auto& shard = getShard(_key);
+            std::unique_lock lk(shard.lock);
+            return shard.removeObject(_obj, _key);
+        }
+
+        inline bool findAndStoreRange(const K& _key, size_t& _inOutStorageSize, MutablePairType* _out) const
+        {
+            const auto& shard = getShard(_key);
+            std::shared_lock lk(shard.lock);
+            return shard.findAndStoreRange(_key, _inOutStorageSize, _out);
+        }
+
+        inline bool findAndStoreRange(const K& _key, size_t& _inOutStorageSize, V* _out) const
+        {
+            const auto& shard = getShard(_key);
+            std::shared_lock lk(shard.lock);
+            return shard.findAndStoreRange(_key, _inOutStorageSize, _out);
+        }
+
+        inline bool outputAll(size_t& _inOutStorageSize, MutablePairType* _out) const
+        {
+            // same contract as `CObjectCacheBase::outputRange`, query the required size with a null `_out`
+            if (!_out)
+            {
+                _inOutStorageSize = getSize();
+                return false;
+            }
+            bool r = true;
+            size_t written = 0ull;
+            for (const auto& shard : m_shards)
+            {
+                std::shared_lock lk(shard.lock);
+                size_t sz = _inOutStorageSize-written;
+                r = shard.outputAll(sz, _out+written) && r;
+                written += sz;
+            }
+            _inOutStorageSize = written;
+            return r;
+        }
+
+        inline bool changeObjectKey(const V& _obj, const K& _key, const K& _newKey)
+        {
+            auto& oldShard = getShard(_key);
+            auto& newShard = getShard(_newKey);
+            if (&oldShard==&newShard)
+            {
+                std::unique_lock lk(oldShard.lock);
+                return oldShard.changeObjectKey(_obj, _key, _newKey);
+            }
+
+            // `std::scoped_lock` orders the acquisition so two opposite re-keyings can't deadlock
+            std::scoped_lock lk(oldShard.lock,newShard.lock);
+            constexpr bool DoGreetOrDispose = false;
+            if (oldShard.template removeObject<DoGreetOrDispose>(_obj, _key))
+            {
+                newShard.template insert<DoGreetOrDispose>(_newKey, _obj);
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        template<size_t... Ix>
+        inline CMakeCacheConcurrentSharded(const GreetFuncType& _greeting, const DisposalFuncType& _disposal, std::index_sequence<Ix...>)
+            : m_shards{{SShard((void(Ix),_greeting),_disposal)...}} {}
+
+        inline uint32_t getShardIndex(const K& _key) const
+        {
+            size_t h = std::hash<std::remove_cv_t<KeyType>>()(_key);
+            // identity hashes (pointers, integers) keep their entropy in the middle bits
+            h ^= h>>17u;
+            h *= 0x9E3779B97F4A7C15ull;
+            return static_cast<uint32_t>(h>>32u)&(ShardCount-1u);
+        }
+        inline SShard& getShard(const K& _key) {return m_shards[getShardIndex(_key)];}
+        inline const SShard& getShard(const K& _key) const {return m_shards[getShardIndex(_key)];}
+
+        std::array<SShard,ShardCount> m_shards;
+    };
 }
 
 template<
@@ -165,6 +347,28 @@ using CConcurrentMultiObjectCache =
         CMultiObjectCache<K, T, ContainerT_T, Alloc>
     >;
 
+template<
+    typename K,
+    typename T,
+    template<typename...> class ContainerT_T = std::vector,
+    typename Alloc = core::allocator<typename impl::key_val_pair_type_for<ContainerT_T, K, T>::type>
+>
+using CShardedConcurrentObjectCache =
+    impl::CMakeCacheConcurrentSharded<
+        CObjectCache<K, T, ContainerT_T, Alloc>
+    >;
+
+template<
+    typename K,
+    typename T,
+    template<typename...> class ContainerT_T = std::vector,
+    typename Alloc = core::allocator<typename impl::key_val_pair_type_for<ContainerT_T, K, T>::type>
+>
+using CShardedConcurrentMultiObjectCache =
+    impl::CMakeCacheConcurrentSharded<
+        CMultiObjectCache<K, T, ContainerT_T, Alloc>
+    >;
+
 }}
 
 #endif
@@ -0,0 +1,84 @@
+// Copyright (C) 2018-2023 - DevSH Graphics Programming Sp. z O.O.
+// This file is part of the "Nabla Engine".
+// For conditions of distribution and use, see copyright notice in nabla.h
+#ifndef _NBL_ASSET_C_FILE_MAPPED_CPU_BUFFER_H_INCLUDED_
+#define _NBL_ASSET_C_FILE_MAPPED_CPU_BUFFER_H_INCLUDED_
+
+#include "nbl/system/IFile.h"
+
+#include "nbl/asset/ICPUBuffer.h"
+
+namespace nbl::asset
+{
+
+//! ICPUBuffer exposing a range of an `IFile`'s mapping directly, without any allocation or `memcpy`
+/*
+    Holds a reference to the file so the mapping stays alive for as long as the buffer does,
+    pages get faulted in lazily by the OS as the data gets read.
+
+    The mapping is treated as read-only, the first non-const `getPointer()` makes a private heap copy
+    of the range and releases the file (copy-on-write), so prefer const access when you only read.
+    Restoring a dummy buffer from this one goes through the same copy, so the mapping never gets handed over.
+*/
+class CFileMappedCPUBuffer final : public ICPUBuffer
+{
+    public:
+        //! Returns nullptr if the file has no readable mapping or the range doesn't fit in the file
+        static inline core::smart_refctd_ptr<CFileMappedCPUBuffer> create(core::smart_refctd_ptr<system::IFile>&& file, const size_t offset=0ull, size_t size=~0ull)
+        {
+            if (!file)
+                return nullptr;
+            const system::IFile* constFile = file.get();
+            const auto* mapped = reinterpret_cast<const uint8_t*>(constFile->getMappedPointer());
+            const size_t fileSize = file->getSize();
+            if (!mapped || offset>=fileSize)
+                return nullptr;
+            if (size>fileSize-offset)
+                size = fileSize-offset;
+            return core::smart_refctd_ptr<CFileMappedCPUBuffer>(new CFileMappedCPUBuffer(std::move(file),const_cast<uint8_t*>(mapped+offset),size),core::dont_grab);
+        }
+
+        //! nullptr once the contents got copied out of the mapping (or the buffer was converted to a dummy)
+        inline const system::IFile* getBackingFile() const {return m_file.get();}
+
+    protected:
+        inline CFileMappedCPUBuffer(core::smart_refctd_ptr<system::IFile>&& file, void* mappedData, const size_t size) : ICPUBuffer(size,mappedData), m_file(std::move(file)) {}
+        inline ~CFileMappedCPUBuffer()
+        {
+            freeData();
+        }
+
+        inline void freeData() override
+        {
+            // mapping is owned by the file, only our private copy needs freeing
+            if (m_file)
+            {
+                m_file = nullptr;
+                data = nullptr;
+                m_creationParams.size = 0ull;
+            }
+            else
+                ICPUBuffer::freeData();
+        }
+
+        inline void* getWritablePointer_impl() override
+        {
+            if (m_file)
+            {
+                void* copy = _NBL_ALIGNED_MALLOC(m_creationParams.size,_NBL_SIMD_ALIGNMENT);
+                if (!copy)
+                    return nullptr;
+                memcpy(copy,data,m_creationParams.size);
+                data = copy;
+                m_file = nullptr;
+            }
+            return data;
+        }
+
+    private:
+        core::smart_refctd_ptr<system::IFile> m_file;
+};
+
+}
+
+#endif
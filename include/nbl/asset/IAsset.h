@@ -5,8 +5,11 @@
 #define _NBL_ASSET_I_ASSET_H_INCLUDED_
 
 #include "nbl/core/decl/smart_refctd_ptr.h"
+#include "nbl/core/xxHash256.h"
 
 #include <string>
+#include <optional>
+#include <functional>
 
 namespace nbl::asset
 {
@@ -218,6 +221,31 @@ class IAsset : virtual public core::IReferenceCounted
 			return _levelsBelow ? isAnyDependencyDummy_impl(_levelsBelow) : false;
 		}
 
+		//! 256bit hash of the asset's contents, stable across runs so it can be compared between assets loaded from different files
+		using content_hash_t = std::array<uint64_t,4>;
+		//! Memoizes the hashes of already visited assets so a dependency shared by many assets only gets hashed once, not thread-safe
+		using content_hash_cache_t = core::unordered_map<const IAsset*,std::optional<content_hash_t>>;
+		//! Recursive Merkle-style hash, the asset's own state is hashed together with the content hashes of its direct dependencies (never their pointers).
+		/** Equal hashes mean the two assets and their whole dependency graphs are interchangeable.
+		Empty if the asset or anything it depends on is a dummy, or of a type which doesn't implement `computeContentHash_impl` yet. */
+		NBL_API2 std::optional<content_hash_t> computeContentHash(content_hash_cache_t* cache=nullptr) const;
+
+		//! Gets called with every direct dependency of an asset, returning non-null replaces that dependency (with an asset of the same type and content)
+		using dependency_visitor_t = std::function<IAsset*(const IAsset*)>;
+		//! Read-only walk over the direct dependencies
+		inline void visitDependencies(const std::function<void(const IAsset*)>& visitor) const
+		{
+			const_cast<IAsset*>(this)->visitDependencies_impl([&visitor](const IAsset* dependency)->IAsset*{visitor(dependency);return nullptr;});
+		}
+		//! Returns false and leaves the dependencies untouched for immutable assets
+		inline bool replaceDependencies(const dependency_visitor_t& visitor)
+		{
+			if (getMutability()==EM_IMMUTABLE)
+				return false;
+			visitDependencies_impl(visitor);
+			return true;
+		}
+
     protected:
 		inline static void restoreFromDummy_impl_call(IAsset* _this_child, IAsset* _other_child, uint32_t _levelsBelow)
 		{
@@ -229,6 +257,44 @@ class IAsset : virtual public core::IReferenceCounted
 		// returns if any of `this`'s up to `_levelsBelow` levels below is dummy
 		virtual bool isAnyDependencyDummy_impl(uint32_t _levelsBelow) const { return false; }
 
+		//! What gets fed to the hash function, derived classes append their state and their dependencies to it
+		struct SContentHashInput
+		{
+			template<typename T> requires (std::is_arithmetic_v<T>||std::is_enum_v<T>)
+			inline void append(const T value)
+			{
+				append(&value,sizeof(T));
+			}
+			inline void append(const void* data, const size_t size)
+			{
+				const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+				input.insert(input.end(),bytes,bytes+size);
+			}
+			//! Appends the dependency's content hash, or a marker if it is null. Returns false if the dependency can't be hashed and neither can the asset depending on it then.
+			NBL_API2 bool appendDependency(const IAsset* dependency);
+
+			core::vector<uint8_t> input;
+			content_hash_cache_t& cache;
+		};
+		//! To be implemented by derived classes, the asset type is already in the `input`. Return false if the state can't be hashed.
+		virtual bool computeContentHash_impl(SContentHashInput& input) const { return false; }
+		//! Hashes raw bytes, big arrays get split into fixed size chunks hashed in parallel so the result doesn't depend on the thread count
+		NBL_API2 static content_hash_t hashContentBytes(const void* data, const size_t size);
+
+		//! To be implemented by derived classes holding references to other assets, must call `visitDependency` on each of them in a fixed order
+		virtual void visitDependencies_impl(const dependency_visitor_t& visitor) {}
+		template<class DependencyType>
+		static inline void visitDependency(core::smart_refctd_ptr<DependencyType>& dependency, const dependency_visitor_t& visitor)
+		{
+			if (!dependency)
+				return;
+			if (auto* replacement=visitor(dependency.get()))
+			{
+				assert(replacement->getAssetType()==dependency->getAssetType());
+				dependency = core::smart_refctd_ptr<DependencyType>(static_cast<DependencyType*>(replacement));
+			}
+		}
+
         inline void clone_common(IAsset* _clone) const
         {
             assert(!isDummyObjectForCacheAliasing);
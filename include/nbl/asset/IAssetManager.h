@@ -7,6 +7,7 @@
 
 #include <array>
 #include <ostream>
+#include <span>
 
 #include "nbl/core/declarations.h"
 #include "nbl/system/path.h"
@@ -22,6 +23,7 @@
 
 
 #define USE_MAPS_FOR_PATH_BASED_CACHE //benchmark and choose, paths can be full system paths
+#define USE_SHARDED_ASSET_CACHE //hash-partitioned locks, otherwise one spinlock guards each asset type's whole cache
 
 namespace nbl::asset
 {
@@ -37,7 +39,8 @@ std::function<void(SAssetBundle&)> makeAssetDisposeFunc(const IAssetManager* con
 /**
 	It provides a loading, writing and creation functionality that is almost thread-safe.
 	There is one issue with threading, starting loading the same asset at the exact same time 
-	may end up with two copies in the cache.
+	may end up with two copies in the cache. Use getAssetAsync() if that matters, it coalesces
+	concurrent requests for the same file into a single load.
 
 	IAssetManager performs caching of CPU assets associated with resource handles such as names, 
 	filenames, UUIDs. However there are separate caches for each asset type.
@@ -52,10 +55,17 @@ class NBL_API2 IAssetManager : public core::IReferenceCounted
         friend std::function<void(SAssetBundle&)> makeAssetDisposeFunc(const IAssetManager* const _mgr);
 
     public:
+#ifdef USE_SHARDED_ASSET_CACHE
+        template<typename K, typename T, template<typename...> class ContainerT_T>
+        using AssetCacheBaseType = core::CShardedConcurrentMultiObjectCache<K, T, ContainerT_T>;
+#else
+        template<typename K, typename T, template<typename...> class ContainerT_T>
+        using AssetCacheBaseType = core::CConcurrentMultiObjectCache<K, T, ContainerT_T>;
+#endif //USE_SHARDED_ASSET_CACHE
 #ifdef USE_MAPS_FOR_PATH_BASED_CACHE
-        using AssetCacheType = core::CConcurrentMultiObjectCache<std::string, SAssetBundle, std::multimap>;
+        using AssetCacheType = AssetCacheBaseType<std::string, SAssetBundle, std::multimap>;
 #else
-        using AssetCacheType = core::CConcurrentMultiObjectCache<std::string, IAssetBundle, std::vector>;
+        using AssetCacheType = AssetCacheBaseType<std::string, IAssetBundle, std::vector>;
 #endif //USE_MAPS_FOR_PATH_BASED_CACHE
 
         using CpuGpuCacheType = core::CConcurrentObjectCache<const IAsset*, core::smart_refctd_ptr<core::IReferenceCounted> >;
@@ -123,12 +133,77 @@ class NBL_API2 IAssetManager : public core::IReferenceCounted
         // called as a part of constructor only
         void initializeMeshTools();
 
+        class CAsyncLoadQueue;
+        // one load per file in flight, every request for the same file with the same parameters gets sent to the same queue
+        // and the first one to execute does the loading, the rest just copy its result so no loader thread ever waits on another
+        struct SInFlightLoad
+        {
+            inline SInFlightLoad(std::string&& _key, const IAssetLoader::SAssetLoadParams& _params, const IAssetLoader::IAssetLoaderOverride* _override, CAsyncLoadQueue* _queue) :
+                key(std::move(_key)), params(_params), override(_override), queue(_queue) {}
+
+            // everything that can change what gets loaded needs to match
+            inline bool compatible(const IAssetLoader::SAssetLoadParams& _params, const IAssetLoader::IAssetLoaderOverride* _override) const
+            {
+                return override==_override && params.cacheFlags==_params.cacheFlags && params.loaderFlags==_params.loaderFlags &&
+                    params.meshManipulatorOverride==_params.meshManipulatorOverride && params.restoreLevels==_params.restoreLevels &&
+                    params.reload==_params.reload && params.workingDirectory==_params.workingDirectory &&
+                    params.decryptionKeyLen==_params.decryptionKeyLen && params.decryptionKey==_params.decryptionKey;
+            }
+
+            const std::string key;
+            const IAssetLoader::SAssetLoadParams params;
+            const IAssetLoader::IAssetLoaderOverride* const override;
+            CAsyncLoadQueue* const queue;
+            // guarded by `m_inFlightLoadsMutex`
+            uint32_t pending = 1u;
+            // only ever touched by the thread of `queue`
+            bool done = false;
+            SAssetBundle result;
+        };
+        // async loading, the request needs to be default constructible and move assignable which `SAssetLoadParams` isn't
+        struct SAsyncLoadRequest
+        {
+            SAsyncLoadRequest() = default;
+            inline SAsyncLoadRequest(std::string&& _filename, const IAssetLoader::SAssetLoadParams& _params, IAssetLoader::IAssetLoaderOverride* _override, std::shared_ptr<SInFlightLoad>&& _inFlight) :
+                filename(std::move(_filename)), params(std::make_unique<IAssetLoader::SAssetLoadParams>(_params)), override(_override), inFlight(std::move(_inFlight)) {}
+
+            std::string filename;
+            std::unique_ptr<IAssetLoader::SAssetLoadParams> params;
+            IAssetLoader::IAssetLoaderOverride* override = nullptr;
+            // null when the load doesn't get coalesced
+            std::shared_ptr<SInFlightLoad> inFlight;
+        };
+        class CAsyncLoadQueue final : public system::IAsyncQueueDispatcher<CAsyncLoadQueue,SAsyncLoadRequest,64u>
+        {
+                using base_t = system::IAsyncQueueDispatcher<CAsyncLoadQueue,SAsyncLoadRequest,64u>;
+
+                IAssetManager* m_manager;
+
+            public:
+                inline CAsyncLoadQueue(IAssetManager* _manager) : base_t(base_t::start_on_construction), m_manager(_manager) {}
+
+                void process_request(base_t::future_base_t* _future_base, SAsyncLoadRequest& req);
+
+                void init() {}
+        };
+        SAssetBundle loadCoalesced(SAsyncLoadRequest& req);
+
+        const uint32_t m_asyncLoaderThreadCount;
+        // threads only get spun up on first use of `getAssetAsync`
+        std::once_flag m_asyncLoadQueuesInit;
+        core::vector<std::unique_ptr<CAsyncLoadQueue>> m_asyncLoadQueues;
+        std::atomic_uint32_t m_nextAsyncLoadQueue = 0u;
+        std::mutex m_inFlightLoadsMutex;
+        core::unordered_map<std::string,std::shared_ptr<SInFlightLoad>> m_inFlightLoads;
+
     public:
         //! Constructor
-        explicit IAssetManager(core::smart_refctd_ptr<system::ISystem>&& system, core::smart_refctd_ptr<CCompilerSet>&& compilerSet = nullptr) :
+        /** \param asyncLoaderThreadCount number of threads servicing `getAssetAsync`, 0 means one per hardware thread. */
+        explicit IAssetManager(core::smart_refctd_ptr<system::ISystem>&& system, core::smart_refctd_ptr<CCompilerSet>&& compilerSet = nullptr, const uint32_t asyncLoaderThreadCount = 0u) :
             m_system(std::move(system)),
             m_compilerSet(std::move(compilerSet)),
-            m_defaultLoaderOverride(this)
+            m_defaultLoaderOverride(this),
+            m_asyncLoaderThreadCount(asyncLoaderThreadCount ? asyncLoaderThreadCount:core::max(std::thread::hardware_concurrency(),1u))
         {
             initializeMeshTools();
 
@@ -150,6 +225,11 @@ class NBL_API2 IAssetManager : public core::IReferenceCounted
     protected:
 		virtual ~IAssetManager()
 		{
+			// finish every request already submitted so no future is left waiting forever, then join the loader threads before tearing down the caches they use
+			for (auto& queue : m_asyncLoadQueues)
+				queue->waitForIdle();
+			m_asyncLoadQueues.clear();
+
 			for (size_t i = 0u; i < m_assetCache.size(); ++i)
 				if (m_assetCache[i])
 					delete m_assetCache[i];
@@ -418,6 +498,14 @@ class NBL_API2 IAssetManager : public core::IReferenceCounted
         {
             return getAssetInHierarchyWholeBundleRestore(_file, _supposedFilename, _params, 0u, _override);
         }
+        template<typename T>
+        using future_t = system::ISystem::future_t<T>;
+        //! Asynchronous `getAsset`, the load happens on one of the asset manager's loader threads and the result lands in `future`.
+        /** Concurrent requests for the same file (relative to the same working directory and with the same override) get coalesced into
+        a single load, unless ECF_DUPLICATE_TOP_LEVEL is requested. The `future` and `_override` must outlive the request, the future can be cancelled
+        as long as loading hasn't started yet. Loaders should still use the synchronous `getAssetInHierarchy` for their dependencies. */
+        void getAssetAsync(future_t<SAssetBundle>& future, const std::string& _filename, const IAssetLoader::SAssetLoadParams& _params, IAssetLoader::IAssetLoaderOverride* _override=nullptr);
+
         //TODO change name
         SAssetBundle getAssetWholeBundleRestore(const std::string& _filename, const IAssetLoader::SAssetLoadParams& _params)
         {
@@ -546,6 +634,20 @@ class NBL_API2 IAssetManager : public core::IReferenceCounted
                     m_assetCache[i]->clear();
         }
 
+        //! What `deduplicate` managed to merge
+        struct SDeduplicationStatistics
+        {
+            //! Duplicates which are not referenced from the bundles anymore, the asset caches can still hold onto them
+            uint32_t assetsRemoved = 0u;
+            //! Sum of their `conservativeSizeEstimate()`
+            size_t bytesSaved = 0ull;
+        };
+        //! Makes everything in the bundles' dependency graphs reference a single asset out of every group with equal `IAsset::computeContentHash`, also across bundles.
+        /** Merging happens in place, the bundles' root assets are never replaced because metadata is keyed by them, neither are the dependencies of immutable assets.
+        Nothing else may be reading or writing the assets of the bundles at the same time. */
+        SDeduplicationStatistics deduplicate(std::span<const SAssetBundle> bundles);
+        inline SDeduplicationStatistics deduplicate(const SAssetBundle& bundle) {return deduplicate({&bundle,1ull});}
+
 
         //! This function does not free the memory consumed by IAssets, but allows you to cache GPU objects already created from given assets so that no unnecessary GPU-side duplicates get created.
         /** Keeping assets around (by their pointers) helps a lot by making sure that the same asset is not converted to a gpu resource multiple times, or created and deleted multiple times.
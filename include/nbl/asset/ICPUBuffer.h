@@ -70,7 +70,7 @@ class ICPUBuffer : public asset::IBuffer, public asset::IAsset
         void* getPointer() 
         { 
             assert(!isImmutable_debug());
-            return data;
+            return getWritablePointer_impl();
         }
 
         bool canBeRestoredFrom(const IAsset* _other) const override final
@@ -108,9 +108,26 @@ class ICPUBuffer : public asset::IBuffer, public asset::IAsset
             // NO THIS IS A NIGHTMARE!
             // FIXME: ONLY SWAP FOR COMPATIBLE ALLOCATORS! OTHERWISE MEMCPY!
             if (willBeRestoredFrom(_other))
+            {
+                // storage we'd not own (e.g. a file mapping) can't be handed over, make the other take a private copy first
+                if (!other->getWritablePointer_impl())
+                    return;
                 std::swap(data, other->data);
+            }
         }
 
+        bool computeContentHash_impl(SContentHashInput& input) const override
+        {
+            input.append(m_creationParams.size);
+            input.append(m_creationParams.usage.value);
+            const auto bytesHash = hashContentBytes(data,m_creationParams.size);
+            input.append(bytesHash.data(),sizeof(bytesHash));
+            return true;
+        }
+
+        //! Derivatives whose storage can't be written to in-place (e.g. a file mapping) can copy on write here
+        virtual void* getWritablePointer_impl() {return data;}
+
         // REMEMBER TO CALL FROM DTOR!
         // TODO: idea, make the `ICPUBuffer` an ADT, and use the default allocator CCPUBuffer instead for consistency
         // TODO: idea make a macro for overriding all `delete` operators of a class to enforce a finalizer that runs in reverse order to destructors (to allow polymorphic cleanups)
@@ -90,6 +90,19 @@ class ICPUBufferView : public IBufferView<ICPUBuffer>, public IAsset
 			return m_buffer->isAnyDependencyDummy(_levelsBelow-1u);
 		}
 
+		bool computeContentHash_impl(SContentHashInput& input) const override
+		{
+			input.append(m_offset);
+			input.append(m_size);
+			input.append(m_format);
+			return input.appendDependency(m_buffer.get());
+		}
+
+		void visitDependencies_impl(const dependency_visitor_t& visitor) override
+		{
+			visitDependency(m_buffer,visitor);
+		}
+
 		virtual ~ICPUBufferView() = default;
 };
 
@@ -95,6 +95,7 @@ class NBL_API2 ICPUDescriptorSet final : public IDescriptorSet<ICPUDescriptorSet
 		void restoreFromDummy_impl(IAsset* _other, uint32_t _levelsBelow) override;
 
 		bool isAnyDependencyDummy_impl(uint32_t _levelsBelow) const override;
+		void visitDependencies_impl(const dependency_visitor_t& visitor) override;
 
 		virtual ~ICPUDescriptorSet() = default;
 
@@ -235,6 +235,48 @@ class ICPUImage final : public IImage, public IAsset
 			return buffer->isAnyDependencyDummy(_levelsBelow);
 		}
 
+		bool computeContentHash_impl(SContentHashInput& input) const override
+		{
+			// member by member, the structs have padding
+			input.append(m_creationParams.type);
+			input.append(m_creationParams.samples);
+			input.append(m_creationParams.format);
+			input.append(m_creationParams.extent.width);
+			input.append(m_creationParams.extent.height);
+			input.append(m_creationParams.extent.depth);
+			input.append(m_creationParams.mipLevels);
+			input.append(m_creationParams.arrayLayers);
+			input.append(m_creationParams.flags.value);
+			input.append(m_creationParams.usage.value);
+			input.append(m_creationParams.stencilUsage.value);
+			for (auto f=0u; f<m_creationParams.viewFormats.size(); f++)
+				input.append<uint8_t>(m_creationParams.viewFormats.test(f));
+			const auto regionRange = getRegions();
+			input.append(regionRange.size());
+			for (const auto& region : regionRange)
+			{
+				input.append(region.bufferOffset);
+				input.append(region.bufferRowLength);
+				input.append(region.bufferImageHeight);
+				input.append(region.imageSubresource.aspectMask.value);
+				input.append(region.imageSubresource.mipLevel);
+				input.append(region.imageSubresource.baseArrayLayer);
+				input.append(region.imageSubresource.layerCount);
+				input.append(region.imageOffset.x);
+				input.append(region.imageOffset.y);
+				input.append(region.imageOffset.z);
+				input.append(region.imageExtent.width);
+				input.append(region.imageExtent.height);
+				input.append(region.imageExtent.depth);
+			}
+			return input.appendDependency(buffer.get());
+		}
+
+		void visitDependencies_impl(const dependency_visitor_t& visitor) override
+		{
+			visitDependency(buffer,visitor);
+		}
+
 		ICPUImage(const SCreationParams& _params) : IImage(_params)
 		{
 		}
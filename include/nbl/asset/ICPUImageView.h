@@ -118,6 +118,29 @@ class ICPUImageView final : public IImageView<ICPUImage>, public IAsset
 			return params.image->isAnyDependencyDummy(_levelsBelow);
 		}
 
+		bool computeContentHash_impl(SContentHashInput& input) const override
+		{
+			input.append(params.flags);
+			input.append(params.subUsages.value);
+			input.append(params.viewType);
+			input.append(params.format);
+			input.append(params.components.r);
+			input.append(params.components.g);
+			input.append(params.components.b);
+			input.append(params.components.a);
+			input.append(params.subresourceRange.aspectMask.value);
+			input.append(params.subresourceRange.baseMipLevel);
+			input.append(params.subresourceRange.levelCount);
+			input.append(params.subresourceRange.baseArrayLayer);
+			input.append(params.subresourceRange.layerCount);
+			return input.appendDependency(params.image.get());
+		}
+
+		void visitDependencies_impl(const dependency_visitor_t& visitor) override
+		{
+			visitDependency(params.image,visitor);
+		}
+
 		virtual ~ICPUImageView() = default;
 };
 
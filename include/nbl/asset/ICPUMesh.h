@@ -147,6 +147,12 @@ class ICPUMesh final : public IMesh<ICPUMeshBuffer>, public BlobSerializable, pu
 			return false;
 		}
 
+		void visitDependencies_impl(const dependency_visitor_t& visitor) override
+		{
+			for (auto& mb : m_meshBuffers)
+				visitDependency(mb,visitor);
+		}
+
 		core::vector<core::smart_refctd_ptr<ICPUMeshBuffer>> m_meshBuffers;
 };
 
@@ -760,6 +760,18 @@ class ICPUMeshBuffer final : public IMeshBuffer<ICPUBuffer,ICPUDescriptorSet,ICP
 
             return (m_indexBufferBinding.buffer && m_indexBufferBinding.buffer->isAnyDependencyDummy(_levelsBelow));
         }
+
+        // bypasses the setters on purpose, a replacement has the same content and usage flags
+        void visitDependencies_impl(const dependency_visitor_t& visitor) override
+        {
+            visitDependency(m_pipeline,visitor);
+            visitDependency(m_descriptorSet,visitor);
+            visitDependency(m_inverseBindPoseBufferBinding.buffer,visitor);
+            visitDependency(m_jointAABBBufferBinding.buffer,visitor);
+            for (uint32_t i = 0u; i < MAX_ATTR_BUF_BINDING_COUNT; ++i)
+                visitDependency(m_vertexBufferBindings[i].buffer,visitor);
+            visitDependency(m_indexBufferBinding.buffer,visitor);
+        }
 };
 
 }
@@ -89,6 +89,25 @@ protected:
 		{
 			
 		}
+
+		bool computeContentHash_impl(SContentHashInput& input) const override
+		{
+			// bitfields, so go through the values
+			input.append(m_params.TextureWrapU);
+			input.append(m_params.TextureWrapV);
+			input.append(m_params.TextureWrapW);
+			input.append(m_params.BorderColor);
+			input.append(m_params.MinFilter);
+			input.append(m_params.MaxFilter);
+			input.append(m_params.MipmapMode);
+			input.append(m_params.AnisotropicFilter);
+			input.append(m_params.CompareEnable);
+			input.append(m_params.CompareFunc);
+			input.append(m_params.LodBias);
+			input.append(m_params.MinLod);
+			input.append(m_params.MaxLod);
+			return true;
+		}
 };
 
 }
@@ -125,6 +125,21 @@ class ICPUShader : public IAsset, public IShader
 			return m_code->isAnyDependencyDummy(_levelsBelow);
 		}
 
+		// `m_code` is const so the shader doesn't expose it to `visitDependencies_impl`
+		bool computeContentHash_impl(SContentHashInput& input) const override
+		{
+			input.append(m_contentType);
+			input.append(getStage());
+			// relative includes in high level source get resolved against the path
+			if (isContentHighLevelLanguage())
+			{
+				const auto& path = getFilepathHint();
+				input.append(path.size());
+				input.append(path.data(),path.size());
+			}
+			return input.appendDependency(m_code.get());
+		}
+
 		const core::smart_refctd_ptr<ICPUBuffer> m_code;
 		const E_CONTENT_TYPE m_contentType;
 };
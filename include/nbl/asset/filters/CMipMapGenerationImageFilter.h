@@ -8,6 +8,7 @@
 #include "nbl/core/declarations.h"
 
 #include "nbl/asset/filters/CBlitImageFilter.h"
+#include "nbl/asset/filters/CSwizzleAndConvertImageFilter.h"
 
 namespace nbl
 {
@@ -22,6 +23,9 @@ namespace asset
 // but iterative application of the filter will give you 2/originalResolution, 6/originalResolution, 14/originalResolution supports
 // the correct usage is to compute the first mip map with a 100% support kernel, then subsequent iterations with 50% smaller pixel supports
 // (actually in the case of using a Gaussian for both resampling and reconstruction, this is equivalent to using a single kernel of 3,3,5,9,..)
+// With `CState::fuseMipChain` the levels get computed from each other in a full precision (FusedFormat) scratch pyramid instead of
+// being decoded back from the image, so the quantization error doesn't compound, and each level gets encoded only once at the very end.
+// In that mode the Swizzle, Dither, Normalization and Clamp are only applied during that final encode (so `alphaChannel` refers to the unswizzled channels).
 
 template<typename Swizzle=VoidSwizzle, typename Dither=IdentityDither/*TODO: WhiteNoiseDither*/, typename Normalization=void, bool Clamp=true, typename BlitUtilities = CBlitUtilities<CChannelIndependentWeightFunction1D<CConvolutionWeightFunction1D<CWeightFunction1D<SKaiserFunction>, CWeightFunction1D<SMitchellFunction<>>>>>>
 class CMipMapGenerationImageFilter : public CImageFilter<CMipMapGenerationImageFilter<Swizzle, Dither, Normalization, Clamp, BlitUtilities>>, public CBasicImageFilterCommon
@@ -31,7 +35,12 @@ class CMipMapGenerationImageFilter : public CImageFilter<CMipMapGenerationImageF
 
 	private:
 		using state_base_t = typename CBlitImageFilterBase<Swizzle,Dither,Normalization,Clamp>::CStateBase;
+		using swizzle_state_t = typename impl::CSwizzleableAndDitherableFilterBase<Swizzle,Dither,Normalization,Clamp>::state_type;
 		using pseudo_base_t = CBlitImageFilter<Swizzle,Dither,Normalization,Clamp,BlitUtilities>;
+		// the fused chain filters between scratch levels without any of the encode-time processing
+		using fused_blit_t = CBlitImageFilter<VoidSwizzle,IdentityDither,void,false,BlitUtilities>;
+		using fused_load_t = CSwizzleAndConvertImageFilter<EF_UNKNOWN,EF_UNKNOWN,VoidSwizzle,IdentityDither,void,false>;
+		using fused_store_t = CSwizzleAndConvertImageFilter<EF_UNKNOWN,EF_UNKNOWN,Swizzle,Dither,Normalization,Clamp>;
 
 	public:
 		class CState : public IImageFilter::IState, public state_base_t
@@ -44,6 +53,8 @@ class CMipMapGenerationImageFilter : public CImageFilter<CMipMapGenerationImageF
 				uint32_t							startMipLevel = 1u;
 				uint32_t							endMipLevel = 0u;
 				ICPUImage*							inOutImage = nullptr;
+				//! Keep the intermediate levels at full precision and encode each level only once, see the comment above the class
+				bool								fuseMipChain = false;
 		};
 		using state_type = CState;
 		
@@ -89,6 +100,9 @@ class CMipMapGenerationImageFilter : public CImageFilter<CMipMapGenerationImageF
 			if (!validate(state))
 				return false;
 
+			if (state->fuseMipChain)
+				return executeFused(std::forward<ExecutionPolicy>(policy),state);
+
 			for (auto inMipLevel=state->startMipLevel; inMipLevel!=state->endMipLevel; inMipLevel++)
 			{
 				auto blit = buildBlitState(state, inMipLevel);
@@ -102,7 +116,113 @@ class CMipMapGenerationImageFilter : public CImageFilter<CMipMapGenerationImageF
 			return execute(core::execution::seq,state);
 		}
 
+		//! Scratch image format the fused chain keeps the levels in
+		static inline constexpr E_FORMAT FusedFormat = EF_R32G32B32A32_SFLOAT;
+
 	protected:
+		template<class ExecutionPolicy>
+		static inline bool executeFused(const ExecutionPolicy& policy, state_type* state)
+		{
+			const uint32_t firstLevel = state->startMipLevel-1u;
+			auto pyramid = createFusedPyramid(state);
+			if (!pyramid)
+				return false;
+
+			// decode the source level once
+			{
+				typename fused_load_t::state_type load;
+				load.extentLayerCount = state->inOutImage->getMipSize(firstLevel);
+				load.layerCount = state->layerCount;
+				load.inOffsetBaseLayer = core::vectorSIMDu32(0u,0u,0u,state->baseLayer);
+				load.outOffsetBaseLayer = core::vectorSIMDu32(0u,0u,0u,0u);
+				load.inMipLevel = load.outMipLevel = firstLevel;
+				load.inImage = state->inOutImage;
+				load.outImage = pyramid.get();
+				if (!fused_load_t::execute(policy,&load))
+					return false;
+			}
+
+			// every level is filtered from the previous full precision one, the blit parallelizes over its lines with the policy
+			for (auto inMipLevel=state->startMipLevel; inMipLevel!=state->endMipLevel; inMipLevel++)
+			{
+				const auto prevLevel = inMipLevel-1u;
+
+				auto convolutionKernels = fused_blit_t::blit_utils_t::getConvolutionKernels(pyramid->getMipSize(prevLevel),pyramid->getMipSize(inMipLevel));
+
+				typename fused_blit_t::state_type blit(std::move(convolutionKernels));
+				blit.inOffsetBaseLayer = blit.outOffsetBaseLayer = core::vectorSIMDu32(0u,0u,0u,0u);
+				blit.inExtentLayerCount = pyramid->getMipSize(prevLevel);
+				blit.outExtentLayerCount = pyramid->getMipSize(inMipLevel);
+				blit.inLayerCount = blit.outLayerCount = state->layerCount;
+				blit.inMipLevel = prevLevel;
+				blit.outMipLevel = inMipLevel;
+				blit.inImage = blit.outImage = pyramid.get();
+				blit.scratchMemory = state->scratchMemory;
+				blit.scratchMemoryByteSize = state->scratchMemoryByteSize;
+				std::copy_n(state->axisWraps,state_base_t::NumWrapAxes,blit.axisWraps);
+				blit.borderColor = state->borderColor;
+				blit.alphaSemantic = state->alphaSemantic;
+				blit.alphaRefValue = state->alphaRefValue;
+				blit.alphaChannel = state->alphaChannel;
+				blit.recomputeScaledKernelPhasedLUT();
+				if (!fused_blit_t::execute(policy,&blit))
+					return false;
+			}
+
+			// and only now encode, with the user's swizzle, dither, normalization and clamp
+			for (auto outMipLevel=state->startMipLevel; outMipLevel!=state->endMipLevel; outMipLevel++)
+			{
+				typename fused_store_t::state_type store;
+				static_cast<swizzle_state_t&>(store) = static_cast<const swizzle_state_t&>(*state);
+				store.extentLayerCount = pyramid->getMipSize(outMipLevel);
+				store.layerCount = state->layerCount;
+				store.inOffsetBaseLayer = core::vectorSIMDu32(0u,0u,0u,0u);
+				store.outOffsetBaseLayer = core::vectorSIMDu32(0u,0u,0u,state->baseLayer);
+				store.inMipLevel = store.outMipLevel = outMipLevel;
+				store.inImage = pyramid.get();
+				store.outImage = state->inOutImage;
+				if (!fused_store_t::execute(policy,&store))
+					return false;
+			}
+			return true;
+		}
+
+		// only allocates the levels the chain reads or writes, the lower ones stay without regions
+		static inline core::smart_refctd_ptr<ICPUImage> createFusedPyramid(const state_type* state)
+		{
+			const uint32_t firstLevel = state->startMipLevel-1u;
+
+			IImage::SCreationParams params(state->inOutImage->getCreationParameters());
+			params.format = FusedFormat;
+			params.mipLevels = state->endMipLevel;
+			params.arrayLayers = state->layerCount;
+			params.flags = IImage::ECF_NONE;
+			params.viewFormats = {};
+			auto pyramid = ICPUImage::create(std::move(params));
+			if (!pyramid)
+				return nullptr;
+
+			auto regions = core::make_refctd_dynamic_array<core::smart_refctd_dynamic_array<IImage::SBufferCopy> >(state->endMipLevel-firstLevel);
+			size_t bufferSize = 0ull;
+			for (auto rit=regions->begin(); rit!=regions->end(); rit++)
+			{
+				const auto mipLevel = firstLevel+static_cast<uint32_t>(std::distance(regions->begin(),rit));
+				const auto localExtent = pyramid->getMipSize(mipLevel);
+				rit->bufferOffset = bufferSize;
+				rit->bufferRowLength = localExtent.x;
+				rit->bufferImageHeight = localExtent.y;
+				rit->imageSubresource.aspectMask = IImage::EAF_COLOR_BIT;
+				rit->imageSubresource.mipLevel = mipLevel;
+				rit->imageSubresource.baseArrayLayer = 0u;
+				rit->imageSubresource.layerCount = state->layerCount;
+				rit->imageOffset = { 0u,0u,0u };
+				rit->imageExtent = { localExtent.x,localExtent.y,localExtent.z };
+				bufferSize += size_t(localExtent.x)*localExtent.y*localExtent.z*state->layerCount*getTexelOrBlockBytesize<FusedFormat>();
+			}
+			pyramid->setBufferAndRegions(core::make_smart_refctd_ptr<ICPUBuffer>(bufferSize),std::move(regions));
+			return pyramid;
+		}
+
 		static inline auto buildBlitState(const state_type* state, uint32_t inMipLevel)
 		{
 			const auto prevLevel = inMipLevel-1u;
@@ -27,17 +27,40 @@ class CSummedAreaTableImageFilterBase
 			public:
 
 				static inline constexpr size_t decodeTypeByteSize = sizeof(double);
+				static inline constexpr size_t singlePrecisionDecodeTypeByteSize = sizeof(float);
 				uint8_t*	scratchMemory = nullptr;										//!< memory covering all regions used for temporary filling within computation of sum values
 				size_t	scratchMemoryByteSize = {};											//!< required byte size for entire scratch memory
 				bool normalizeImageByTotalSATValues = false;								//!< after sum performation division will be performed for the entire image by the max sum values in (maxX, 0, z) depending on input image - needed for UNORM and SNORM
 				uint8_t axesToSum = 0u;														//!< which axes you want to sum; X: bit0, Y: bit1, Z: bit2 // TODO: make ALL_AXES the default and make sure examples using it work as expected.
+				bool accumulateInSinglePrecision = false;									//!< sum in float or uint32_t instead of double or uint64_t which halves the scratch, integer formats whose total could overflow 32bit keep summing in 64bit
 
-				static inline size_t getRequiredScratchByteSize(const ICPUImage* inputImage, asset::VkExtent3D extent)
+				//! Whether the sums will really be done in 32bit, see `accumulateInSinglePrecision`
+				static inline bool usesSinglePrecision(const ICPUImage* inputImage, asset::VkExtent3D extent, bool accumulateInSinglePrecision)
+				{
+					if (!accumulateInSinglePrecision)
+						return false;
+
+					const auto format = inputImage->getCreationParameters().format;
+					if (!isIntegerFormat(format))
+						return true;
+
+					const double texelCount = double(extent.width)*double(extent.height)*double(extent.depth);
+					for (uint32_t channel=0u; channel<getFormatChannelCount(format); channel++)
+					{
+						const double maxMagnitude = core::max(core::abs(getFormatMaxValue<double>(format,channel)),core::abs(getFormatMinValue<double>(format,channel)));
+						if (maxMagnitude*texelCount>double(INT32_MAX))
+							return false;
+					}
+					return true;
+				}
+
+				static inline size_t getRequiredScratchByteSize(const ICPUImage* inputImage, asset::VkExtent3D extent, bool accumulateInSinglePrecision=false)
 				{
 					const auto& inputCreationParams = inputImage->getCreationParameters();
 					const auto channels = asset::getFormatChannelCount(inputCreationParams.format);
+					const size_t accumulatorByteSize = usesSinglePrecision(inputImage,extent,accumulateInSinglePrecision) ? singlePrecisionDecodeTypeByteSize:decodeTypeByteSize;
 
-					size_t retval = extent.width * extent.height * extent.depth * channels * decodeTypeByteSize;
+					size_t retval = extent.width * extent.height * extent.depth * channels * accumulatorByteSize;
 					
 					return retval;
 				}
@@ -94,7 +117,7 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 			const auto inFormat = inParams.format;
 			const auto outFormat = outParams.format;
 
-			if (state->scratchMemoryByteSize < state_type::getRequiredScratchByteSize(state->inImage, state->extent))
+			if (state->scratchMemoryByteSize < state_type::getRequiredScratchByteSize(state->inImage, state->extent, state->accumulateInSinglePrecision))
 				return false;
 			
 			if (state->axesToSum == 0u)
@@ -116,10 +139,19 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 				return false;
 
 			auto checkFormat = state->inImage->getCreationParameters().format;
+			const bool singlePrecision = state_type::usesSinglePrecision(state->inImage, state->extent, state->accumulateInSinglePrecision);
 			if (isIntegerFormat(checkFormat))
-				return executeInterprated(std::forward<ExecutionPolicy>(policy), state, reinterpret_cast<uint64_t*>(state->scratchMemory));
+			{
+				if (singlePrecision)
+					return executeInterprated<ExecutionPolicy,uint64_t>(std::forward<ExecutionPolicy>(policy), state, reinterpret_cast<uint32_t*>(state->scratchMemory));
+				return executeInterprated<ExecutionPolicy,uint64_t>(std::forward<ExecutionPolicy>(policy), state, reinterpret_cast<uint64_t*>(state->scratchMemory));
+			}
 			else
-				return executeInterprated(std::forward<ExecutionPolicy>(policy), state, reinterpret_cast<double*>(state->scratchMemory));
+			{
+				if (singlePrecision)
+					return executeInterprated<ExecutionPolicy,double>(std::forward<ExecutionPolicy>(policy), state, reinterpret_cast<float*>(state->scratchMemory));
+				return executeInterprated<ExecutionPolicy,double>(std::forward<ExecutionPolicy>(policy), state, reinterpret_cast<double*>(state->scratchMemory));
+			}
 		}	
 		static inline bool execute(state_type* state)
 		{
@@ -127,49 +159,48 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 		}
 
 	private:
+		// scan tiles are this many texels wide, so the column scans walk down contiguous strips of memory
+		static inline constexpr uint32_t ScanTileWidth = 64u;
 
-		template<class ExecutionPolicy, typename decodeType> //!< double or uint64_t
-		static inline bool executeInterprated(ExecutionPolicy&& policy, state_type* state, decodeType* scratchMemory)
+		template<class ExecutionPolicy, typename decodeType, typename accumType> //!< decodeType is double or uint64_t, accumType is either the same or its 32bit counterpart
+		static inline bool executeInterprated(ExecutionPolicy&& policy, state_type* state, accumType* scratchMemory)
 		{
 			const asset::E_FORMAT inFormat = state->inImage->getCreationParameters().format;
 			const asset::E_FORMAT outFormat = state->outImage->getCreationParameters().format;
-			const auto inTexelByteSize = asset::getTexelOrBlockBytesize(inFormat);
-			const auto outTexelByteSize = asset::getTexelOrBlockBytesize(outFormat);
 			const auto currentChannelCount = asset::getFormatChannelCount(inFormat);
-			const auto arrayLayers = state->inImage->getCreationParameters().arrayLayers;
+			const bool isSignedIntegerFormat = asset::isIntegerFormat(outFormat) && asset::isSignedFormat(outFormat);
 			static constexpr auto maxChannels = 4u;
 
 			#ifdef _NBL_DEBUG
 			memset(scratchMemory, 0, state->scratchMemoryByteSize);
 			#endif // _NBL_DEBUG
 
-			const core::vector3du32_SIMD scratchByteStrides = [&]()
+			const uint32_t width = state->extent.width;
+			const uint32_t height = state->extent.height;
+			const uint32_t depth = state->extent.depth;
+			const uint32_t scratchTexelByteSize = currentChannelCount*sizeof(accumType);
+			const core::vector3du32_SIMD scratchByteStrides(scratchTexelByteSize, scratchTexelByteSize*width, scratchTexelByteSize*width*height);
+			// in elements of accumType
+			const size_t rowPitch = size_t(width)*currentChannelCount;
+			const size_t slicePitch = rowPitch*height;
+
+			// runs `f(a,b)` for every `a<extentA` and `b<extentB` with the execution policy
+			auto forEachBatch = [&policy](const uint32_t extentA, const uint32_t extentB, auto f) -> void
 			{
-				const core::vectorSIMDu32 trueExtent = state->extentLayerCount;
-
-				switch (currentChannelCount)
-				{
-					case 1:
-					{
-						return TexelBlockInfo(asset::E_FORMAT::EF_R64_SFLOAT).convert3DTexelStridesTo1DByteStrides(trueExtent);
-					}
-
-					case 2:
-					{
-						return TexelBlockInfo(asset::E_FORMAT::EF_R64G64_SFLOAT).convert3DTexelStridesTo1DByteStrides(trueExtent);
-					}
+				constexpr uint32_t batch_dims = 2u;
+				const uint32_t batchExtent[batch_dims] = {extentA,extentB};
+				CBasicImageFilterCommon::BlockIterator<batch_dims> begin(batchExtent);
+				const uint32_t spaceFillingEnd[batch_dims] = {0u,extentB};
+				CBasicImageFilterCommon::BlockIterator<batch_dims> end(begin.getExtentBatches(),spaceFillingEnd);
+				std::for_each(policy,begin,end,[&f](const std::array<uint32_t,batch_dims>& batchCoord) -> void {f(batchCoord[0],batchCoord[1]);});
+			};
 
-					case 3:
-					{
-						return TexelBlockInfo(asset::E_FORMAT::EF_R64G64B64_SFLOAT).convert3DTexelStridesTo1DByteStrides(trueExtent);
-					}
-					case 4:
-					{
-						return TexelBlockInfo(asset::E_FORMAT::EF_R64G64B64A64_SFLOAT).convert3DTexelStridesTo1DByteStrides(trueExtent);
-					}
-				}
-			}();
-			const auto scratchTexelByteSize = scratchByteStrides[0];
+			auto storeDecoded = [&](const size_t offset, const decodeType* decodeBuffer) -> void
+			{
+				accumType* dst = reinterpret_cast<accumType*>(reinterpret_cast<uint8_t*>(scratchMemory)+offset);
+				for (auto i=0u; i<currentChannelCount; ++i)
+					dst[i] = static_cast<accumType>(decodeBuffer[i]);
+			};
 
 			const auto&& [copyInBaseLayer, copyOutBaseLayer, copyLayerCount] = std::make_tuple(state->inBaseLayer, state->outBaseLayer, state->layerCount);
 			state->layerCount = 1u;
@@ -182,11 +213,8 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 				state->layerCount = copyLayerCount;
 			};
 
-			for (uint16_t w = 0u; w < copyLayerCount; ++w) // this could be parallelized
+			for (uint16_t w = 0u; w < copyLayerCount; ++w) // the scratch only holds one layer at a time
 			{
-				std::array<decodeType, maxChannels> minDecodeValues = {};
-				std::array<decodeType, maxChannels> maxDecodeValues = {};
-
 				{
 					const uint8_t* inData = reinterpret_cast<const uint8_t*>(state->inImage->getBuffer()->getPointer());
 					const auto blockDims = asset::getBlockDimensions(state->inImage->getCreationParameters().format);
@@ -223,7 +251,7 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 									{
 										asset::decodePixelsRuntime(inFormat, inSourcePixels, decodeBuffer, blockX, blockY);
 										const size_t movedOffset = asset::IImage::SBufferCopy::getLocalByteOffset(core::vector3du32_SIMD(movedLocalOutPos.x + blockX, movedLocalOutPos.y + blockY, movedLocalOutPos.z), scratchByteStrides);
-										memcpy(reinterpret_cast<uint8_t*>(scratchMemory) + movedOffset, decodeBuffer, scratchTexelByteSize);
+										storeDecoded(movedOffset, decodeBuffer);
 									}
 							}
 						}
@@ -235,7 +263,7 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 								{
 									asset::decodePixelsRuntime(inFormat, inSourcePixels, decodeBuffer, blockX, blockY);
 									const size_t offset = asset::IImage::SBufferCopy::getLocalByteOffset(core::vector3du32_SIMD(localOutPos.x + blockX, localOutPos.y + blockY, localOutPos.z), scratchByteStrides);
-									memcpy(reinterpret_cast<uint8_t*>(scratchMemory) + offset, decodeBuffer, scratchTexelByteSize);
+									storeDecoded(offset, decodeBuffer);
 								}
 						}
 					};
@@ -249,132 +277,125 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 
 					if constexpr (ExclusiveMode)
 					{
-						core::vector3du32_SIMD localCoord;
-						for (auto& z = localCoord[2] = 0u; z < state->extent.depth; ++z) // TODO: parallelize
-							for (auto& y = localCoord[1] = 0u; y < state->extent.height; ++y)
-								for (auto& x = localCoord[0] = 0u; x < state->extent.width; ++x)
+						forEachBatch(height, depth, [&](const uint32_t y, const uint32_t z) -> void
+						{
+							core::vector3du32_SIMD localCoord(0u, y, z);
+							for (auto& x = localCoord[0] = 0u; x < width; ++x)
+							{
+								const auto doesItMoveOnYZorXZorXY = (localCoord < movingOnYZorXZorXYCheckingVector);
+								if (doesItMoveOnYZorXZorXY.any())
 								{
-									auto resetSATMemory = [&](const core::vector3du32_SIMD& position)
-									{
-										const size_t offset = asset::IImage::SBufferCopy::getLocalByteOffset(position, scratchByteStrides);
-										memset(reinterpret_cast<uint8_t*>(scratchMemory) + offset, 0, scratchTexelByteSize);
-									};
-
-									const auto doesItMoveOnYZorXZorXY = (localCoord < movingOnYZorXZorXYCheckingVector);
-									if (doesItMoveOnYZorXZorXY.any())
-										resetSATMemory(localCoord);
+									const size_t offset = asset::IImage::SBufferCopy::getLocalByteOffset(localCoord, scratchByteStrides);
+									memset(reinterpret_cast<uint8_t*>(scratchMemory) + offset, 0, scratchTexelByteSize);
 								}
+							}
+						});
 					}
 				}
 
 				{
-					auto getScratchPixel = [&](core::vector4di32_SIMD readBlockPos) -> decodeType*
+					/*
+						The summed area table is separable, so instead of the sequential inclusion-exclusion over the 8 neighbouring boxes
+						we do an inclusive prefix sum along each summed axis in turn. Every pass is independent across the lines orthogonal
+						to its axis, so the lines (tiles of columns for the Y and Z passes) get spread over the execution policy.
+					*/
+					const uint32_t tileCount = (width+ScanTileWidth-1u)/ScanTileWidth;
+					auto getTileRange = [&](const uint32_t tile) -> std::pair<size_t,size_t>
 					{
-						const size_t scratchOffset = asset::IImage::SBufferCopy::getLocalByteOffset(core::vector3du32_SIMD(readBlockPos.x, readBlockPos.y, readBlockPos.z, 0), scratchByteStrides);
-						return reinterpret_cast<decodeType*>(reinterpret_cast<uint8_t*>(scratchMemory) + scratchOffset);
+						const size_t begin = size_t(tile)*ScanTileWidth*currentChannelCount;
+						return {begin,core::min<size_t>(begin+size_t(ScanTileWidth)*currentChannelCount,rowPitch)};
 					};
 
-					auto sum = [&](core::vectorSIMDi32 readBlockPos) -> void
+					if (((state->axesToSum >> 0) & 0x1u) && width>1u)
 					{
-						decodeType* current = getScratchPixel(readBlockPos);
-
-						auto areAxisSafe = [&]()
+						forEachBatch(height, depth, [&](const uint32_t y, const uint32_t z) -> void
 						{
-							const auto position = core::vectorSIMDi32(0u, 0u, 0u, 0u);
-
-							const bool shouldSumX = (state->axesToSum >> 0) & 0x1u;
-							const bool shouldSumY = (state->axesToSum >> 1) & 0x1u;
-							const bool shouldSumZ = (state->axesToSum >> 2) & 0x1u;
-
-							return core::vector4du32_SIMD
-							(
-								(readBlockPos.x > position.x) && (shouldSumX),
-								(readBlockPos.y > position.y) && (shouldSumY),
-								(readBlockPos.z > position.z) && (shouldSumZ),
-								(readBlockPos.w > position.w)
-							);
-						};
-
-						auto addScratchPixelToCurrentOne = [&](const decodeType* values)
+							accumType* row = scratchMemory + z*slicePitch + y*rowPitch;
+							for (size_t i = currentChannelCount; i < rowPitch; ++i)
+								row[i] += row[i-currentChannelCount];
+						});
+					}
+					if (((state->axesToSum >> 1) & 0x1u) && height>1u)
+					{
+						forEachBatch(tileCount, depth, [&](const uint32_t tile, const uint32_t z) -> void
 						{
-							for (auto i = 0; i < currentChannelCount; ++i)
-								current[i] += values[i];
-						};
-						
-						auto substractScratchPixelFromCurrentOne = [&](const decodeType* values)
+							const auto [begin, end] = getTileRange(tile);
+							accumType* slice = scratchMemory + z*slicePitch;
+							for (uint32_t y = 1u; y < height; ++y)
+							{
+								accumType* current = slice + y*rowPitch;
+								const accumType* previous = current - rowPitch;
+								for (size_t i = begin; i < end; ++i)
+									current[i] += previous[i];
+							}
+						});
+					}
+					if (((state->axesToSum >> 2) & 0x1u) && depth>1u)
+					{
+						forEachBatch(tileCount, height, [&](const uint32_t tile, const uint32_t y) -> void
 						{
-							for (auto i = 0; i < currentChannelCount; ++i)
-								current[i] -= values[i];
-						};
-
-						const auto axisSafe = areAxisSafe();
+							const auto [begin, end] = getTileRange(tile);
+							for (uint32_t z = 1u; z < depth; ++z)
+							{
+								accumType* current = scratchMemory + z*slicePitch + y*rowPitch;
+								const accumType* previous = current - slicePitch;
+								for (size_t i = begin; i < end; ++i)
+									current[i] += previous[i];
+							}
+						});
+					}
 
-						if (axisSafe.z)
-							addScratchPixelToCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(0, 0, 1, 0)));					// add box x<=current_x && y<=current_y && z<current_z
-						if (axisSafe.y)
+					auto normalizeScratch = [&](bool isSignedFormat)
+					{
+						// per row extrema first, then a tiny serial reduction, the extrema start at 0 like they always did
+						core::vector<std::array<accumType,maxChannels>> rowMinValues(size_t(height)*depth), rowMaxValues(size_t(height)*depth);
+						forEachBatch(height, depth, [&](const uint32_t y, const uint32_t z) -> void
 						{
-							addScratchPixelToCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(0, 1, 0, 0)));					// add box x<=current_x && y<current_y && z<=current_z
-							if (axisSafe.z)
-								substractScratchPixelFromCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(0, 1, 1, 0)));		// remove overlap box x<=current_x && y<current_y && z<current_z
-						}
-
-						/*
-							Now I have the sum of all layers below me in the bound x<=current_x && y<=current_y && z<current_z and the current pixel.
-							Time to add the missing top layer pixels.
-						*/
+							auto& minValues = rowMinValues[size_t(z)*height+y];
+							auto& maxValues = rowMaxValues[size_t(z)*height+y];
+							minValues = {};
+							maxValues = {};
+							const accumType* row = scratchMemory + z*slicePitch + y*rowPitch;
+							for (size_t i = 0u; i < rowPitch; i += currentChannelCount)
+							for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
+							{
+								minValues[channel] = core::min(minValues[channel], row[i+channel]);
+								maxValues[channel] = core::max(maxValues[channel], row[i+channel]);
+							}
+						});
 
-						if (axisSafe.x)
+						std::array<double, maxChannels> minDecodeValues = {};
+						std::array<double, maxChannels> maxDecodeValues = {};
 						{
-							addScratchPixelToCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(1, 0, 0, 0)));					 // add box x<current_x && y<=current_y && z<=current_z
-							if (axisSafe.z)
-								substractScratchPixelFromCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(1, 0, 1, 0)));		 // remove overlap box x<current_x && y<=current_y && z<current_z
-							if (axisSafe.y)
+							std::array<accumType, maxChannels> minValues = {};
+							std::array<accumType, maxChannels> maxValues = {};
+							for (size_t r = 0u; r < rowMinValues.size(); ++r)
+							for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
 							{
-								substractScratchPixelFromCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(1, 1, 0, 0)));		 // remove future overlap box x<current_x && y<current_y && z<=current_z
-								if (axisSafe.z)
-									addScratchPixelToCurrentOne(getScratchPixel(readBlockPos - core::vectorSIMDi32(1, 1, 1, 0)));			 // add box x<current_x && y<current_y && z<current_z
+								minValues[channel] = core::min(minValues[channel], rowMinValues[r][channel]);
+								maxValues[channel] = core::max(maxValues[channel], rowMaxValues[r][channel]);
+							}
+							for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
+							{
+								minDecodeValues[channel] = static_cast<double>(minValues[channel]);
+								maxDecodeValues[channel] = static_cast<double>(maxValues[channel]);
 							}
 						}
 
-						std::for_each(current, current + currentChannelCount,
-							[&](const decodeType& itrValue)
+						forEachBatch(height, depth, [&](const uint32_t y, const uint32_t z) -> void
+						{
+							accumType* row = scratchMemory + z*slicePitch + y*rowPitch;
+							for (size_t i = 0u; i < rowPitch; i += currentChannelCount)
 							{
-								uint8_t offset = &itrValue - current;
-
-								if (maxDecodeValues[offset] < itrValue)
-									maxDecodeValues[offset] = itrValue;
-
-								if (minDecodeValues[offset] > itrValue)
-									minDecodeValues[offset] = itrValue;
+								accumType* entryScratchAdress = row + i;
+								if (isSignedFormat)
+									for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
+										entryScratchAdress[channel] = static_cast<accumType>((2.0 * static_cast<double>(entryScratchAdress[channel]) - maxDecodeValues[channel] - minDecodeValues[channel]) / (maxDecodeValues[channel] - minDecodeValues[channel]));
+								else
+									for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
+										entryScratchAdress[channel] = static_cast<accumType>((static_cast<double>(entryScratchAdress[channel]) - minDecodeValues[channel]) / (maxDecodeValues[channel] - minDecodeValues[channel]));
 							}
-						);
-					};
-
-					{
-						core::vector3du32_SIMD localCoord;
-						for (auto& z = localCoord[2] = 0u; z < state->extent.depth; ++z)  // TODO: parallelize (will be tough!)
-							for (auto& y = localCoord[1] = 0u; y < state->extent.height; ++y)
-								for (auto& x = localCoord[0] = 0u; x < state->extent.width; ++x)
-									sum(core::vectorSIMDu32(x, y, z));
-					}
-
-					auto normalizeScratch = [&](bool isSignedFormat)
-					{
-						core::vector3du32_SIMD localCoord;
-							for (auto& z = localCoord[2] = 0u; z < state->extent.depth; ++z) // TODO: parallelize
-								for (auto& y = localCoord[1] = 0u; y < state->extent.height; ++y)
-									for (auto& x = localCoord[0] = 0u; x < state->extent.width; ++x)
-									{
-										const size_t scratchOffset = asset::IImage::SBufferCopy::getLocalByteOffset(localCoord, scratchByteStrides);
-										decodeType* entryScratchAdress = reinterpret_cast<decodeType*>(reinterpret_cast<uint8_t*>(scratchMemory) + scratchOffset);
-
-										if(isSignedFormat)
-											for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
-												entryScratchAdress[channel] = (2.0 * entryScratchAdress[channel] - maxDecodeValues[channel] - minDecodeValues[channel]) / (maxDecodeValues[channel] - minDecodeValues[channel]);
-										else
-											for (uint8_t channel = 0; channel < currentChannelCount; ++channel)
-												entryScratchAdress[channel] = (entryScratchAdress[channel] - minDecodeValues[channel]) / (maxDecodeValues[channel] - minDecodeValues[channel]);
-									}
+						});
 					};
 
 					bool normalized = asset::isNormalizedFormat(inFormat);
@@ -391,7 +412,22 @@ class CSummedAreaTableImageFilter : public CMatchedSizeInOutImageFilterCommon, p
 							uint8_t* outDataAdress = outData + writeBlockArrayOffset;
 
 							const size_t offset = asset::IImage::SBufferCopy::getLocalByteOffset(localOutPos, scratchByteStrides);
-							asset::encodePixelsRuntime(outFormat, outDataAdress, reinterpret_cast<uint8_t*>(scratchMemory) + offset); // overrrides texels, so region-overlapping case is fine
+							const accumType* scratchTexel = reinterpret_cast<const accumType*>(reinterpret_cast<uint8_t*>(scratchMemory) + offset);
+							if constexpr (std::is_same_v<accumType,decodeType>)
+								asset::encodePixelsRuntime(outFormat, outDataAdress, scratchTexel); // overrrides texels, so region-overlapping case is fine
+							else
+							{
+								// the encoders want 64bit values, signed integers need sign extending from 32bit
+								decodeType encodeBuffer[maxChannels] = {};
+								for (auto i = 0u; i < currentChannelCount; ++i)
+								{
+									if constexpr (std::is_integral_v<accumType>)
+										encodeBuffer[i] = isSignedIntegerFormat ? static_cast<decodeType>(static_cast<int64_t>(static_cast<int32_t>(scratchTexel[i]))):static_cast<decodeType>(scratchTexel[i]);
+									else
+										encodeBuffer[i] = static_cast<decodeType>(scratchTexel[i]);
+								}
+								asset::encodePixelsRuntime(outFormat, outDataAdress, encodeBuffer);
+							}
 						};
 
 						IImage::SSubresourceLayers subresource = { static_cast<IImage::E_ASPECT_FLAGS>(0u), state->outMipLevel, state->outBaseLayer, 1 };
@@ -93,6 +93,73 @@ class CSwizzleAndConvertImageFilterBase : public CSwizzleableAndDitherableFilter
 				state->normalization.finalize<encodeBufferType>();
 			}
 		}
+
+		//! Whether `executeRowSpans` can replace the per-texel loop for this pair of runtime formats
+		static inline bool canExecuteRowSpans(const E_FORMAT inFormat, const E_FORMAT outFormat)
+		{
+			// integer texels travel as raw 64bit patterns through the double buffers, keep them on the per-texel path
+			for (const auto format : {inFormat,outFormat})
+			if (isBlockCompressionFormat(format) || isPlanarFormat(format) || isIntegerFormat(format))
+				return false;
+			return true;
+		}
+
+		/*
+			Row-batched variant of the runtime swizzle and convert, the span decoder and encoder get picked once
+			instead of switching on the format for every texel. The swizzle, dither, normalization and clamp
+			still happen per texel in double precision, so the results are identical to the per-texel path.
+		*/
+		template<class ExecutionPolicy>
+		static inline bool executeRowSpans(const ExecutionPolicy& policy, state_type* state, const E_FORMAT inFormat, const E_FORMAT outFormat)
+		{
+			const auto decodeSpan = getDecodePixelSpanFunc<double>(inFormat);
+			const auto encodeSpan = getEncodePixelSpanFunc<double>(outFormat);
+			const uint32_t inChannelsAmount = asset::getFormatChannelCount(inFormat);
+			const uint32_t outChannelsAmount = asset::getFormatChannelCount(outFormat);
+			const uint32_t inTexelSize = asset::getTexelOrBlockBytesize(inFormat);
+			const uint32_t outTexelSize = asset::getTexelOrBlockBytesize(outFormat);
+
+			auto perOutputRegion = [&](const CMatchedSizeInOutImageFilterCommon::CommonExecuteData& commonExecuteData, CBasicImageFilterCommon::clip_region_functor_t& clip) -> bool
+			{
+				auto swizzleRow = [&](uint32_t readBlockArrayOffset, core::vectorSIMDu32 readBlockPos, uint32_t texelCount)
+				{
+					constexpr uint32_t MaxChannels = 4u;
+					constexpr uint32_t SpanSize = 256u;
+					double decoded[MaxChannels][SpanSize];
+					double encoded[MaxChannels][SpanSize];
+					double* const decodedChannels[MaxChannels] = {decoded[0],decoded[1],decoded[2],decoded[3]};
+					const double* const encodedChannels[MaxChannels] = {encoded[0],encoded[1],encoded[2],encoded[3]};
+
+					// no block compression on either side, so blocks are texels and a row is contiguous in both images
+					const auto localOutPos = readBlockPos+commonExecuteData.offsetDifferenceInTexels;
+					const uint8_t* srcRow = commonExecuteData.inData+readBlockArrayOffset;
+					uint8_t* dstRow = commonExecuteData.outData+commonExecuteData.oit->getByteOffset(localOutPos,commonExecuteData.outByteStrides);
+					for (uint32_t spanStart=0u; spanStart<texelCount; spanStart+=SpanSize)
+					{
+						const uint32_t count = core::min(texelCount-spanStart,SpanSize);
+						decodeSpan(inFormat,srcRow+spanStart*inTexelSize,decodedChannels,count);
+						for (uint32_t i=0u; i<count; i++)
+						{
+							double texel[MaxChannels] = {};
+							for (uint32_t c=0u; c<inChannelsAmount; c++)
+								texel[c] = decoded[c][i];
+
+							double decodeBuffer[MaxChannels] = {};
+							base_t::onSwizzle(state, texel, decodeBuffer, inChannelsAmount);
+							const auto position = localOutPos+core::vectorSIMDu32(spanStart+i,0u,0u,0u);
+							base_t::onPreEncode(outFormat, state, decodeBuffer, position, 0u, 0u, outChannelsAmount);
+
+							for (uint32_t c=0u; c<outChannelsAmount; c++)
+								encoded[c][i] = decodeBuffer[c];
+						}
+						encodeSpan(outFormat,dstRow+spanStart*outTexelSize,encodedChannels,count);
+					}
+				};
+				CBasicImageFilterCommon::executePerRegionRow(policy, commonExecuteData.inImg, swizzleRow, commonExecuteData.inRegions.begin(), commonExecuteData.inRegions.end(), clip);
+				return true;
+			};
+			return CMatchedSizeInOutImageFilterCommon::commonExecute(state,perOutputRegion);
+		}
 };
 
 }
@@ -209,6 +276,9 @@ class CSwizzleAndConvertImageFilter<EF_UNKNOWN,EF_UNKNOWN,Swizzle,Dither,Normali
 				assert(blockDims.w==1u);
 			#endif
 			base_t::template normalizationPrepass<EF_UNKNOWN,ExecutionPolicy,double,double>(inFormat,policy,state,blockDims);
+			if (base_t::canExecuteRowSpans(inFormat,outFormat))
+				return base_t::executeRowSpans(policy,state,inFormat,outFormat);
+
 			auto perOutputRegion = [policy,&blockDims,inFormat,outFormat,outChannelsAmount,&state](const CMatchedSizeInOutImageFilterCommon::CommonExecuteData& commonExecuteData, CBasicImageFilterCommon::clip_region_functor_t& clip) -> bool
 			{
 				const uint32_t inChannelsAmount = asset::getFormatChannelCount(inFormat);
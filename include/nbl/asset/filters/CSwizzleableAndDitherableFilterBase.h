@@ -87,7 +87,16 @@ class CSwizzleableAndDitherableFilterBase
 			static_assert(sizeof(Tdec)==8u, "Encode/Decode types must be double, int64_t or uint64_t!");
 			Tdec decoded[4];
 			asset::decodePixelsRuntime(inFormat, srcPix, decoded, blockX, blockY);
-			
+			onSwizzle(state, decoded, decodeBuffer, channelsCount);
+		}
+
+		/*
+			Swizzles an already decoded texel into the decodeBuffer,
+			lets the span (row-batched) decode share the swizzle with onDecode.
+		*/
+		template<typename Tdec>
+		static void onSwizzle(state_type* state, const Tdec* decoded, Tdec* decodeBuffer, uint8_t channelsCount)
+		{
 			Tdec swizzled[4];
 			static_cast<Swizzle&>(*state).template operator() < Tdec, Tdec > (decoded, swizzled);
 			std::copy<const Tdec*, Tdec*>(swizzled, swizzled + channelsCount, decodeBuffer);
@@ -140,6 +149,17 @@ class CSwizzleableAndDitherableFilterBase
 		*/
 		template<typename Tenc>
 		static void onEncode(E_FORMAT outFormat, state_type* state, void* dstPix, Tenc* encodeBuffer, const core::vectorSIMDu32& position, uint32_t blockX, uint32_t blockY, uint8_t channels)
+		{
+			onPreEncode(outFormat, state, encodeBuffer, position, blockX, blockY, channels);
+			asset::encodePixelsRuntime(outFormat, dstPix, encodeBuffer);
+		}
+
+		/*
+			Everything onEncode does before the actual encode,
+			the span (row-batched) encode applies it per texel and then encodes the whole row at once.
+		*/
+		template<typename Tenc>
+		static void onPreEncode(E_FORMAT outFormat, state_type* state, Tenc* encodeBuffer, const core::vectorSIMDu32& position, uint32_t blockX, uint32_t blockY, uint8_t channels)
 		{
 			static_assert(sizeof(Tenc)==8u, "Encode/Decode types must be double, int64_t or uint64_t!");
 			for (uint8_t i = 0; i < channels; ++i)
@@ -160,8 +180,6 @@ class CSwizzleableAndDitherableFilterBase
 					*encodeValue = core::clamp(*encodeValue, min, max);
 				}
 			}
-
-			asset::encodePixelsRuntime(outFormat, dstPix, encodeBuffer);
 		}
 };
 
@@ -229,7 +247,16 @@ class CSwizzleableAndDitherableFilterBase<Swizzle,IdentityDither,Normalization,C
 			static_assert(sizeof(Tdec)==8u, "Encode/Decode types must be double, int64_t or uint64_t!");
 			Tdec decoded[4];
 			asset::decodePixelsRuntime(inFormat, srcPix, decoded, blockX, blockY);
-			
+			onSwizzle(state, decoded, decodeBuffer, channelsCount);
+		}
+
+		/*
+			Swizzles an already decoded texel into the decodeBuffer,
+			lets the span (row-batched) decode share the swizzle with onDecode.
+		*/
+		template<typename Tdec>
+		static void onSwizzle(state_type* state, const Tdec* decoded, Tdec* decodeBuffer, uint8_t channelsCount)
+		{
 			Tdec swizzled[4];
 			static_cast<Swizzle&>(*state).template operator() < Tdec, Tdec > (decoded, swizzled);
 			std::copy<const Tdec*, Tdec*>(swizzled, swizzled + channelsCount, decodeBuffer);
@@ -274,6 +301,17 @@ class CSwizzleableAndDitherableFilterBase<Swizzle,IdentityDither,Normalization,C
 		*/
 		template<typename Tenc>
 		static void onEncode(E_FORMAT outFormat, state_type* state, void* dstPix, Tenc* encodeBuffer, const core::vectorSIMDu32& position, uint32_t blockX, uint32_t blockY, uint8_t channels)
+		{
+			onPreEncode(outFormat, state, encodeBuffer, position, blockX, blockY, channels);
+			asset::encodePixelsRuntime(outFormat, dstPix, encodeBuffer);
+		}
+
+		/*
+			Everything onEncode does before the actual encode,
+			the span (row-batched) encode applies it per texel and then encodes the whole row at once.
+		*/
+		template<typename Tenc>
+		static void onPreEncode(E_FORMAT outFormat, state_type* state, Tenc* encodeBuffer, const core::vectorSIMDu32& position, uint32_t blockX, uint32_t blockY, uint8_t channels)
 		{
 			static_assert(sizeof(Tenc)==8u, "Encode/Decode types must be double, int64_t or uint64_t!");
 
@@ -287,8 +325,6 @@ class CSwizzleableAndDitherableFilterBase<Swizzle,IdentityDither,Normalization,C
 					*encodeValue = core::clamp(*encodeValue, min, max);
 				}
 			}
-
-			asset::encodePixelsRuntime(outFormat, dstPix, encodeBuffer);
 		}
 };
 
@@ -368,7 +404,16 @@ class CSwizzleableAndDitherableFilterBase<PolymorphicSwizzle,Dither,Normalizatio
 			static_assert(sizeof(Tdec)==8u, "Encode/Decode types must be double, int64_t or uint64_t!");
 			Tdec decoded[4];
 			asset::decodePixelsRuntime(inFormat, srcPix, decoded, blockX, blockY);
-			
+			onSwizzle(state, decoded, decodeBuffer, channelsCount);
+		}
+
+		/*
+			Swizzles an already decoded texel into the decodeBuffer,
+			lets the span (row-batched) decode share the swizzle with onDecode.
+		*/
+		template<typename Tdec>
+		static void onSwizzle(state_type* state, const Tdec* decoded, Tdec* decodeBuffer, uint8_t channelsCount)
+		{
 			Tdec swizzled[4];
 			state->swizzle->template operator() < Tdec, Tdec > (decoded, swizzled);
 			std::copy<const Tdec*, Tdec*>(swizzled, swizzled + channelsCount, decodeBuffer);
@@ -421,6 +466,17 @@ class CSwizzleableAndDitherableFilterBase<PolymorphicSwizzle,Dither,Normalizatio
 		*/
 		template<typename Tenc>
 		static void onEncode(E_FORMAT outFormat, state_type* state, void* dstPix, Tenc* encodeBuffer, const core::vectorSIMDu32& position, uint32_t blockX, uint32_t blockY, uint8_t channels)
+		{
+			onPreEncode(outFormat, state, encodeBuffer, position, blockX, blockY, channels);
+			asset::encodePixelsRuntime(outFormat, dstPix, encodeBuffer);
+		}
+
+		/*
+			Everything onEncode does before the actual encode,
+			the span (row-batched) encode applies it per texel and then encodes the whole row at once.
+		*/
+		template<typename Tenc>
+		static void onPreEncode(E_FORMAT outFormat, state_type* state, Tenc* encodeBuffer, const core::vectorSIMDu32& position, uint32_t blockX, uint32_t blockY, uint8_t channels)
 		{
 			static_assert(sizeof(Tenc)==8u, "Encode/Decode types must be double, int64_t or uint64_t!");
 			for (uint8_t i = 0; i < channels; ++i)
@@ -441,8 +497,6 @@ class CSwizzleableAndDitherableFilterBase<PolymorphicSwizzle,Dither,Normalizatio
 					*encodeValue = core::clamp(*encodeValue, min, max);
 				}
 			}
-
-			asset::encodePixelsRuntime(outFormat, dstPix, encodeBuffer);
 		}
 };
 
@@ -1757,6 +1757,110 @@ namespace asset
             decodePixels<double>(_fmt, _pix, reinterpret_cast<double*>(_output), _blockX, _blockY);
     }
 
+    //! Decodes `_count` consecutive texels of a single-plane, non-block-compressed format into channel-planar (SoA) scratch,
+    //! `_output[c][i]` receives channel `c` of texel `i`, channels the format doesn't have are left untouched.
+    /** Integer formats get converted to `T` (so don't use `float` for 32bit integers if you need them exact).
+    Get the function once per region with `getDecodePixelSpanFunc` and the format switch doesn't happen per texel. */
+    template<typename T>
+    using decode_pixel_span_func_t = void(*)(asset::E_FORMAT, const void*, T* const[4], uint32_t);
+
+    namespace impl
+    {
+        template<asset::E_FORMAT fmt, typename T>
+        inline void decodePixelSpan(asset::E_FORMAT, const void* _pix, T* const _output[4], uint32_t _count)
+        {
+            constexpr uint32_t texelSize = getTexelOrBlockBytesize<fmt>();
+            constexpr uint32_t chCnt = getFormatChannelCount<fmt>();
+
+            const uint8_t* src = reinterpret_cast<const uint8_t*>(_pix);
+            for (uint32_t i=0u; i<_count; i++, src+=texelSize)
+            {
+                const void* pix[4] = {src,nullptr,nullptr,nullptr};
+                double decoded[4];
+                decodePixels<fmt,double>(pix,decoded,0u,0u);
+                for (uint32_t c=0u; c<chCnt; c++)
+                    _output[c][i] = static_cast<T>(decoded[c]);
+            }
+        }
+
+        // formats without a dedicated instantiation above still dispatch on the format for every texel
+        template<typename T>
+        inline void decodePixelSpanFallback(asset::E_FORMAT _fmt, const void* _pix, T* const _output[4], uint32_t _count)
+        {
+            const uint32_t texelSize = getTexelOrBlockBytesize(_fmt);
+            const uint32_t chCnt = getFormatChannelCount(_fmt);
+            const bool isInteger = isIntegerFormat(_fmt);
+            const bool isSigned = isSignedFormat(_fmt);
+
+            const uint8_t* src = reinterpret_cast<const uint8_t*>(_pix);
+            for (uint32_t i=0u; i<_count; i++, src+=texelSize)
+            {
+                const void* pix[4] = {src,nullptr,nullptr,nullptr};
+                union
+                {
+                    double asDouble[4];
+                    int64_t asInt[4];
+                    uint64_t asUint[4];
+                } decoded;
+                decodePixelsRuntime(_fmt,pix,decoded.asDouble,0u,0u);
+                for (uint32_t c=0u; c<chCnt; c++)
+                {
+                    if (!isInteger)
+                        _output[c][i] = static_cast<T>(decoded.asDouble[c]);
+                    else if (isSigned)
+                        _output[c][i] = static_cast<T>(decoded.asInt[c]);
+                    else
+                        _output[c][i] = static_cast<T>(decoded.asUint[c]);
+                }
+            }
+        }
+    }
+
+    //! Selects the compile-time specialized span decoder for the common 8/16/32bit and packed formats, or a per-texel fallback.
+    template<typename T>
+    inline decode_pixel_span_func_t<T> getDecodePixelSpanFunc(asset::E_FORMAT _fmt)
+    {
+        static_assert(std::is_floating_point_v<T>, "Span decode only produces floating point!");
+        switch (_fmt)
+        {
+            case asset::EF_R8_UNORM: return &impl::decodePixelSpan<asset::EF_R8_UNORM,T>;
+            case asset::EF_R8G8_UNORM: return &impl::decodePixelSpan<asset::EF_R8G8_UNORM,T>;
+            case asset::EF_R8G8B8_UNORM: return &impl::decodePixelSpan<asset::EF_R8G8B8_UNORM,T>;
+            case asset::EF_B8G8R8_UNORM: return &impl::decodePixelSpan<asset::EF_B8G8R8_UNORM,T>;
+            case asset::EF_R8G8B8A8_UNORM: return &impl::decodePixelSpan<asset::EF_R8G8B8A8_UNORM,T>;
+            case asset::EF_B8G8R8A8_UNORM: return &impl::decodePixelSpan<asset::EF_B8G8R8A8_UNORM,T>;
+            case asset::EF_A8B8G8R8_UNORM_PACK32: return &impl::decodePixelSpan<asset::EF_A8B8G8R8_UNORM_PACK32,T>;
+            case asset::EF_R8_SRGB: return &impl::decodePixelSpan<asset::EF_R8_SRGB,T>;
+            case asset::EF_R8G8_SRGB: return &impl::decodePixelSpan<asset::EF_R8G8_SRGB,T>;
+            case asset::EF_R8G8B8_SRGB: return &impl::decodePixelSpan<asset::EF_R8G8B8_SRGB,T>;
+            case asset::EF_R8G8B8A8_SRGB: return &impl::decodePixelSpan<asset::EF_R8G8B8A8_SRGB,T>;
+            case asset::EF_B8G8R8A8_SRGB: return &impl::decodePixelSpan<asset::EF_B8G8R8A8_SRGB,T>;
+            case asset::EF_R5G6B5_UNORM_PACK16: return &impl::decodePixelSpan<asset::EF_R5G6B5_UNORM_PACK16,T>;
+            case asset::EF_B5G6R5_UNORM_PACK16: return &impl::decodePixelSpan<asset::EF_B5G6R5_UNORM_PACK16,T>;
+            case asset::EF_A2R10G10B10_UNORM_PACK32: return &impl::decodePixelSpan<asset::EF_A2R10G10B10_UNORM_PACK32,T>;
+            case asset::EF_A2B10G10R10_UNORM_PACK32: return &impl::decodePixelSpan<asset::EF_A2B10G10R10_UNORM_PACK32,T>;
+            case asset::EF_R16_UNORM: return &impl::decodePixelSpan<asset::EF_R16_UNORM,T>;
+            case asset::EF_R16G16_UNORM: return &impl::decodePixelSpan<asset::EF_R16G16_UNORM,T>;
+            case asset::EF_R16G16B16A16_UNORM: return &impl::decodePixelSpan<asset::EF_R16G16B16A16_UNORM,T>;
+            case asset::EF_R16_SFLOAT: return &impl::decodePixelSpan<asset::EF_R16_SFLOAT,T>;
+            case asset::EF_R16G16_SFLOAT: return &impl::decodePixelSpan<asset::EF_R16G16_SFLOAT,T>;
+            case asset::EF_R16G16B16A16_SFLOAT: return &impl::decodePixelSpan<asset::EF_R16G16B16A16_SFLOAT,T>;
+            case asset::EF_R32_SFLOAT: return &impl::decodePixelSpan<asset::EF_R32_SFLOAT,T>;
+            case asset::EF_R32G32_SFLOAT: return &impl::decodePixelSpan<asset::EF_R32G32_SFLOAT,T>;
+            case asset::EF_R32G32B32_SFLOAT: return &impl::decodePixelSpan<asset::EF_R32G32B32_SFLOAT,T>;
+            case asset::EF_R32G32B32A32_SFLOAT: return &impl::decodePixelSpan<asset::EF_R32G32B32A32_SFLOAT,T>;
+            case asset::EF_B10G11R11_UFLOAT_PACK32: return &impl::decodePixelSpan<asset::EF_B10G11R11_UFLOAT_PACK32,T>;
+            case asset::EF_E5B9G9R9_UFLOAT_PACK32: return &impl::decodePixelSpan<asset::EF_E5B9G9R9_UFLOAT_PACK32,T>;
+            default: return &impl::decodePixelSpanFallback<T>;
+        }
+    }
+
+    template<typename T>
+    inline void decodePixelSpanRuntime(asset::E_FORMAT _fmt, const void* _pix, T* const _output[4], uint32_t _count)
+    {
+        getDecodePixelSpanFunc<T>(_fmt)(_fmt,_pix,_output,_count);
+    }
+
 
 }
 }
@@ -2640,6 +2640,105 @@ namespace asset
             encodePixels<double>(_fmt, _pix, reinterpret_cast<const double*>(_input));
     }
 
+    //! Encodes `_count` consecutive texels of a single-plane, non-block-compressed format from channel-planar (SoA) scratch,
+    //! the counterpart of `decodePixelSpanRuntime`, `_input[c]` is only read for the channels the format has.
+    template<typename T>
+    using encode_pixel_span_func_t = void(*)(asset::E_FORMAT, void*, const T* const[4], uint32_t);
+
+    namespace impl
+    {
+        template<asset::E_FORMAT fmt, typename T>
+        inline void encodePixelSpan(asset::E_FORMAT, void* _pix, const T* const _input[4], uint32_t _count)
+        {
+            constexpr uint32_t texelSize = getTexelOrBlockBytesize<fmt>();
+            constexpr uint32_t chCnt = getFormatChannelCount<fmt>();
+
+            uint8_t* dst = reinterpret_cast<uint8_t*>(_pix);
+            for (uint32_t i=0u; i<_count; i++, dst+=texelSize)
+            {
+                double texel[4] = {};
+                for (uint32_t c=0u; c<chCnt; c++)
+                    texel[c] = static_cast<double>(_input[c][i]);
+                encodePixels<fmt,double>(dst,texel);
+            }
+        }
+
+        template<typename T>
+        inline void encodePixelSpanFallback(asset::E_FORMAT _fmt, void* _pix, const T* const _input[4], uint32_t _count)
+        {
+            const uint32_t texelSize = getTexelOrBlockBytesize(_fmt);
+            const uint32_t chCnt = getFormatChannelCount(_fmt);
+            const bool isInteger = isIntegerFormat(_fmt);
+            const bool isSigned = isSignedFormat(_fmt);
+
+            uint8_t* dst = reinterpret_cast<uint8_t*>(_pix);
+            for (uint32_t i=0u; i<_count; i++, dst+=texelSize)
+            {
+                union
+                {
+                    double asDouble[4];
+                    int64_t asInt[4];
+                    uint64_t asUint[4];
+                } texel = {};
+                for (uint32_t c=0u; c<chCnt; c++)
+                {
+                    if (!isInteger)
+                        texel.asDouble[c] = static_cast<double>(_input[c][i]);
+                    else if (isSigned)
+                        texel.asInt[c] = static_cast<int64_t>(_input[c][i]);
+                    else
+                        texel.asUint[c] = static_cast<uint64_t>(_input[c][i]);
+                }
+                encodePixelsRuntime(_fmt,dst,texel.asDouble);
+            }
+        }
+    }
+
+    //! Selects the compile-time specialized span encoder for the common 8/16/32bit and packed formats, or a per-texel fallback.
+    template<typename T>
+    inline encode_pixel_span_func_t<T> getEncodePixelSpanFunc(asset::E_FORMAT _fmt)
+    {
+        static_assert(std::is_floating_point_v<T>, "Span encode only consumes floating point!");
+        switch (_fmt)
+        {
+            case asset::EF_R8_UNORM: return &impl::encodePixelSpan<asset::EF_R8_UNORM,T>;
+            case asset::EF_R8G8_UNORM: return &impl::encodePixelSpan<asset::EF_R8G8_UNORM,T>;
+            case asset::EF_R8G8B8_UNORM: return &impl::encodePixelSpan<asset::EF_R8G8B8_UNORM,T>;
+            case asset::EF_B8G8R8_UNORM: return &impl::encodePixelSpan<asset::EF_B8G8R8_UNORM,T>;
+            case asset::EF_R8G8B8A8_UNORM: return &impl::encodePixelSpan<asset::EF_R8G8B8A8_UNORM,T>;
+            case asset::EF_B8G8R8A8_UNORM: return &impl::encodePixelSpan<asset::EF_B8G8R8A8_UNORM,T>;
+            case asset::EF_A8B8G8R8_UNORM_PACK32: return &impl::encodePixelSpan<asset::EF_A8B8G8R8_UNORM_PACK32,T>;
+            case asset::EF_R8_SRGB: return &impl::encodePixelSpan<asset::EF_R8_SRGB,T>;
+            case asset::EF_R8G8_SRGB: return &impl::encodePixelSpan<asset::EF_R8G8_SRGB,T>;
+            case asset::EF_R8G8B8_SRGB: return &impl::encodePixelSpan<asset::EF_R8G8B8_SRGB,T>;
+            case asset::EF_R8G8B8A8_SRGB: return &impl::encodePixelSpan<asset::EF_R8G8B8A8_SRGB,T>;
+            case asset::EF_B8G8R8A8_SRGB: return &impl::encodePixelSpan<asset::EF_B8G8R8A8_SRGB,T>;
+            case asset::EF_R5G6B5_UNORM_PACK16: return &impl::encodePixelSpan<asset::EF_R5G6B5_UNORM_PACK16,T>;
+            case asset::EF_B5G6R5_UNORM_PACK16: return &impl::encodePixelSpan<asset::EF_B5G6R5_UNORM_PACK16,T>;
+            case asset::EF_A2R10G10B10_UNORM_PACK32: return &impl::encodePixelSpan<asset::EF_A2R10G10B10_UNORM_PACK32,T>;
+            case asset::EF_A2B10G10R10_UNORM_PACK32: return &impl::encodePixelSpan<asset::EF_A2B10G10R10_UNORM_PACK32,T>;
+            case asset::EF_R16_UNORM: return &impl::encodePixelSpan<asset::EF_R16_UNORM,T>;
+            case asset::EF_R16G16_UNORM: return &impl::encodePixelSpan<asset::EF_R16G16_UNORM,T>;
+            case asset::EF_R16G16B16A16_UNORM: return &impl::encodePixelSpan<asset::EF_R16G16B16A16_UNORM,T>;
+            case asset::EF_R16_SFLOAT: return &impl::encodePixelSpan<asset::EF_R16_SFLOAT,T>;
+            case asset::EF_R16G16_SFLOAT: return &impl::encodePixelSpan<asset::EF_R16G16_SFLOAT,T>;
+            case asset::EF_R16G16B16A16_SFLOAT: return &impl::encodePixelSpan<asset::EF_R16G16B16A16_SFLOAT,T>;
+            case asset::EF_R32_SFLOAT: return &impl::encodePixelSpan<asset::EF_R32_SFLOAT,T>;
+            case asset::EF_R32G32_SFLOAT: return &impl::encodePixelSpan<asset::EF_R32G32_SFLOAT,T>;
+            case asset::EF_R32G32B32_SFLOAT: return &impl::encodePixelSpan<asset::EF_R32G32B32_SFLOAT,T>;
+            case asset::EF_R32G32B32A32_SFLOAT: return &impl::encodePixelSpan<asset::EF_R32G32B32A32_SFLOAT,T>;
+            case asset::EF_B10G11R11_UFLOAT_PACK32: return &impl::encodePixelSpan<asset::EF_B10G11R11_UFLOAT_PACK32,T>;
+            case asset::EF_E5B9G9R9_UFLOAT_PACK32: return &impl::encodePixelSpan<asset::EF_E5B9G9R9_UFLOAT_PACK32,T>;
+            default: return &impl::encodePixelSpanFallback<T>;
+        }
+    }
+
+    template<typename T>
+    inline void encodePixelSpanRuntime(asset::E_FORMAT _fmt, void* _pix, const T* const _input[4], uint32_t _count)
+    {
+        getEncodePixelSpanFunc<T>(_fmt)(_fmt,_pix,_input,_count);
+    }
+
 
 }
 }
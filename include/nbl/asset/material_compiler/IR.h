@@ -10,65 +10,93 @@
 #include <nbl/asset/ICPUImageView.h>
 #include <nbl/asset/ICPUSampler.h>
 #include <nbl/core/alloc/LinearAddressAllocator.h>
+#include <nbl/core/algorithm/utility.h>
 
 namespace nbl::asset::material_compiler
 {
 
 class IR : public core::IReferenceCounted
 {
+    //! Grows in fixed size chunks which never move, so node pointers stay valid and there is no upper bound on the IR size
     class SBackingMemManager
     {
-        _NBL_STATIC_INLINE_CONSTEXPR size_t INITIAL_MEM_SIZE = 1ull<<20;
-        _NBL_STATIC_INLINE_CONSTEXPR size_t MAX_MEM_SIZE = 1ull<<20;
+        _NBL_STATIC_INLINE_CONSTEXPR uint32_t CHUNK_SIZE_LOG2 = 20u;
+        _NBL_STATIC_INLINE_CONSTEXPR size_t CHUNK_SIZE = 1ull<<CHUNK_SIZE_LOG2;
         _NBL_STATIC_INLINE_CONSTEXPR size_t ALIGNMENT = _NBL_SIMD_ALIGNMENT;
 
-        uint8_t* mem;
-        size_t currSz;
-        using addr_alctr_t = core::LinearAddressAllocator<uint32_t>;
-        addr_alctr_t addrAlctr;
+        struct SChunk
+        {
+            uint8_t* mem;
+            size_t used;
+        };
+        core::vector<SChunk> chunks;
+        //! chunks freed by rewinding, kept around for reuse
+        core::vector<uint8_t*> spareChunks;
+        size_t allocatedSize = 0ull;
 
-    public:
-        SBackingMemManager() : mem(nullptr), currSz(INITIAL_MEM_SIZE), addrAlctr(nullptr, 0u, 0u, ALIGNMENT, MAX_MEM_SIZE) {
-            mem = reinterpret_cast<uint8_t*>(_NBL_ALIGNED_MALLOC(currSz, ALIGNMENT));
+        void pushChunk()
+        {
+            uint8_t* mem;
+            if (spareChunks.empty())
+                mem = reinterpret_cast<uint8_t*>(_NBL_ALIGNED_MALLOC(CHUNK_SIZE, ALIGNMENT));
+            else
+            {
+                mem = spareChunks.back();
+                spareChunks.pop_back();
+            }
+            chunks.push_back({mem,0ull});
         }
+
+    public:
+        SBackingMemManager() = default;
+        SBackingMemManager(const SBackingMemManager&) = delete;
+        SBackingMemManager& operator=(const SBackingMemManager&) = delete;
         ~SBackingMemManager() {
-            _NBL_ALIGNED_FREE(mem);
+            for (auto& chunk : chunks)
+                _NBL_ALIGNED_FREE(chunk.mem);
+            for (auto* mem : spareChunks)
+                _NBL_ALIGNED_FREE(mem);
         }
 
         uint8_t* alloc(size_t bytes)
         {
-            auto addr = addrAlctr.alloc_addr(bytes, ALIGNMENT);
-            assert(addr != addr_alctr_t::invalid_address);
-            //TODO reallocation will invalidate all pointers to nodes, so...
-            //1) never reallocate (just have reasonably big buffer for nodes)
-            //2) make some node_handle class that will work as pointer but is based on offset instead of actual address
-            if (addr+bytes > currSz) {
-                size_t newSz = currSz<<1;
-                if (newSz > MAX_MEM_SIZE) {
-                    addrAlctr.free_addr(addr, bytes);
-                    return nullptr;
-                }
-
-                void* newMem = _NBL_ALIGNED_MALLOC(newSz, ALIGNMENT);
-                memcpy(newMem, mem, currSz);
-                _NBL_ALIGNED_FREE(mem);
-                mem = reinterpret_cast<uint8_t*>(newMem);
-                currSz = newSz;
+            assert(bytes <= CHUNK_SIZE);
+            if (chunks.empty())
+                pushChunk();
+
+            size_t offset = core::roundUp(chunks.back().used, ALIGNMENT);
+            if (offset+bytes > CHUNK_SIZE) {
+                pushChunk();
+                offset = 0ull;
             }
 
-            return mem+addr;
+            auto& chunk = chunks.back();
+            allocatedSize += offset+bytes-chunk.used;
+            chunk.used = offset+bytes;
+            return chunk.mem+offset;
         }
 
-        uint32_t getAllocatedSize() const
+        //! Sum of the bytes taken from every chunk (including alignment padding), differences of this can be passed to `freeLastAllocatedBytes`
+        size_t getAllocatedSize() const
         {
-            return addrAlctr.get_allocated_size();
+            return allocatedSize;
         }
 
-        void freeLastAllocatedBytes(uint32_t _bytes)
+        void freeLastAllocatedBytes(size_t _bytes)
         {
-            assert(addrAlctr.get_allocated_size() >= _bytes);
-            const uint32_t newCursor = addrAlctr.get_allocated_size() - _bytes;
-            addrAlctr.reset(newCursor);
+            assert(allocatedSize >= _bytes);
+            allocatedSize -= _bytes;
+            while (_bytes)
+            {
+                auto& chunk = chunks.back();
+                if (_bytes < chunk.used) {
+                    chunk.used -= _bytes;
+                    break;
+                }
+                _bytes -= chunk.used;
+                spareChunks.push_back(chunk.mem);
+                chunks.pop_back();
+            }
         }
     };
 
@@ -116,9 +144,18 @@ public:
         tmpSize = 0u;
     }
 
-    void addRootNode(INode* node)
+    //! Hash-conses the tree and registers it as a root.
+    /** Returns the node to use in place of `node` from now on, an identical tree added earlier (possibly `node` itself).
+    Identical subtrees of different roots are stored once, the duplicates get destroyed. Within a single root every node stays unique,
+    the backends tell apart the occurrences of a BxDF within a root by node. */
+    INode* addRootNode(INode* node)
     {
-        roots.push_back(node);
+        core::unordered_set<const INode*> usedInRoot;
+        computeMerkleHash(node);
+        INode* canonical = intern(node, usedInRoot);
+        if (std::find(roots.begin(), roots.end(), canonical) == roots.end())
+            roots.push_back(canonical);
+        return canonical;
     }
 
     template <typename NodeType, typename ...Args>
@@ -127,17 +164,18 @@ public:
         tmpSize = 0u;
         return allocNode_impl<NodeType>(std::forward<Args>(args)...);
     }
+    //! The root is registered right away, before any contents are set, so it does not take part in the deduplication
     template <typename NodeType, typename ...Args>
     NodeType* allocRootNode(Args&& ...args)
     {
         auto* root = allocNode<NodeType>(std::forward<Args>(args)...);
-        addRootNode(root);
+        roots.push_back(root);
         return root;
     }
     template <typename NodeType, typename ...Args>
     NodeType* allocTmpNode(Args&& ...args)
     {
-        const uint32_t cursor = memMgr.getAllocatedSize();
+        const size_t cursor = memMgr.getAllocatedSize();
         auto* node = allocNode_impl<NodeType>(std::forward<Args>(args)...);
         tmp.push_back(node);
         tmpSize += (memMgr.getAllocatedSize() - cursor);
@@ -254,9 +292,9 @@ public:
                 switch (source)
                 {
                 case EPS_CONSTANT:
-                    return value.constant==value.constant;
+                    return equalValues(value.constant,rhs.value.constant);
                 case EPS_TEXTURE:
-                    return value.texture==value.texture;
+                    return value.texture==rhs.value.texture;
                 default: return false;
                 }
             }
@@ -325,13 +363,53 @@ public:
 
         using color_t = core::vector3df_SIMD;
 
+        static inline bool equalValues(const float lhs, const float rhs) { return lhs==rhs; }
+        static inline bool equalValues(const color_t& lhs, const color_t& rhs) { return lhs.x==rhs.x && lhs.y==rhs.y && lhs.z==rhs.z; }
+
+        static inline void hashValue(size_t& seed, const float v) { core::hash_combine(seed, v); }
+        static inline void hashValue(size_t& seed, const color_t& v)
+        {
+            core::hash_combine(seed, v.x);
+            core::hash_combine(seed, v.y);
+            core::hash_combine(seed, v.z);
+        }
+        static inline void hashValue(size_t& seed, const STextureSource& v)
+        {
+            core::hash_combine(seed, static_cast<const void*>(v.image.get()));
+            core::hash_combine(seed, static_cast<const void*>(v.sampler.get()));
+            core::hash_combine(seed, v.scale);
+        }
+        template <typename type_of_const>
+        static inline void hashValue(size_t& seed, const SParameter<type_of_const>& v)
+        {
+            core::hash_combine(seed, static_cast<uint32_t>(v.source));
+            if (v.source == EPS_TEXTURE)
+                hashValue(seed, v.value.texture);
+            else
+                hashValue(seed, v.value.constant);
+        }
+
         explicit INode(E_SYMBOL s) : symbol(s) {}
         virtual ~INode() = default;
 
+        //! Hash of everything but the children, overrides must hash the members they add and call the parent's
+        virtual size_t hashContents() const
+        {
+            size_t seed = 0ull;
+            core::hash_combine(seed, static_cast<uint32_t>(symbol));
+            return seed;
+        }
+        //! Compares everything but the children, overrides may assume `other` is of the same type once the parent's comparison succeeds
+        virtual bool equalContents(const INode* other) const
+        {
+            return symbol==other->symbol && children.count==other->children.count;
+        }
+
         // TODO: Why does every INode have children!? Leaf BxDFs do not need this!
         children_array_t children;
         E_SYMBOL symbol;
         bool deinited = false;
+        size_t merkleHash = 0ull; //!< hash of the contents of the whole subtree, valid once the node passed through `addRootNode`
     };
 
     INode* copyNode(const INode* _rhs)
@@ -462,6 +540,21 @@ public:
 
         CGeomModifierNode(E_TYPE t) : INode(ES_GEOM_MODIFIER), type(t) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = INode::hashContents();
+            core::hash_combine(seed, static_cast<uint32_t>(type));
+            hashValue(seed, texture);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            if (!INode::equalContents(_other))
+                return false;
+            auto* other = static_cast<const CGeomModifierNode*>(_other);
+            return type==other->type && texture==other->texture;
+        }
+
         E_TYPE type;
         //no other (than texture) source supported for now (uncomment in the future) [far future TODO]
         //E_SOURCE source;
@@ -476,6 +569,17 @@ public:
     {
         CEmissionNode() : INode(ES_EMISSION) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = INode::hashContents();
+            hashValue(seed, intensity);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return INode::equalContents(_other) && equalValues(intensity, static_cast<const CEmissionNode*>(_other)->intensity);
+        }
+
         color_t intensity = color_t(1.f);
     };
 
@@ -483,6 +587,17 @@ public:
     {
         COpacityNode() : INode(ES_OPACITY) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = INode::hashContents();
+            hashValue(seed, opacity);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return INode::equalContents(_other) && opacity==static_cast<const COpacityNode*>(_other)->opacity;
+        }
+
         SParameter<color_t> opacity;
     };
 
@@ -503,17 +618,54 @@ public:
         E_TYPE type;
 
         CBSDFCombinerNode(E_TYPE t) : INode(ES_BSDF_COMBINER), type(t) {}
+
+        size_t hashContents() const override
+        {
+            size_t seed = INode::hashContents();
+            core::hash_combine(seed, static_cast<uint32_t>(type));
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return INode::equalContents(_other) && type==static_cast<const CBSDFCombinerNode*>(_other)->type;
+        }
     };
     struct CBSDFBlendNode : CBSDFCombinerNode
     {
         CBSDFBlendNode() : CBSDFCombinerNode(ET_WEIGHT_BLEND) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CBSDFCombinerNode::hashContents();
+            hashValue(seed, weight);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return CBSDFCombinerNode::equalContents(_other) && weight==static_cast<const CBSDFBlendNode*>(_other)->weight;
+        }
+
         SParameter<color_t> weight;
     };
     struct CBSDFMixNode : CBSDFCombinerNode
     {
         CBSDFMixNode() : CBSDFCombinerNode(ET_MIX) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CBSDFCombinerNode::hashContents();
+            for (size_t i = 0ull; i < children.count; ++i)
+                hashValue(seed, weights[i]);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            if (!CBSDFCombinerNode::equalContents(_other))
+                return false;
+            auto* other = static_cast<const CBSDFMixNode*>(_other);
+            return std::equal(weights, weights+children.count, other->weights);
+        }
+
         float weights[MAX_CHILDREN];
     };
 
@@ -537,6 +689,22 @@ public:
             etaK(0.f)
         {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = INode::hashContents();
+            core::hash_combine(seed, static_cast<uint32_t>(type));
+            hashValue(seed, eta);
+            hashValue(seed, etaK);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            if (!INode::equalContents(_other))
+                return false;
+            auto* other = static_cast<const CBSDFNode*>(_other);
+            return type==other->type && equalValues(eta, other->eta) && equalValues(etaK, other->etaK);
+        }
+
         E_TYPE type;
         // TODO: why does this base class have IoR!? Diffuse inherits from this!!!
         color_t eta, etaK;
@@ -559,6 +727,23 @@ public:
 
         CMicrofacetSpecularBSDFNode() : CBSDFNode(ET_MICROFACET_SPECULAR) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CBSDFNode::hashContents();
+            core::hash_combine(seed, static_cast<uint32_t>(ndf));
+            core::hash_combine(seed, static_cast<uint32_t>(shadowing));
+            hashValue(seed, alpha_u);
+            hashValue(seed, alpha_v);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            if (!CBSDFNode::equalContents(_other))
+                return false;
+            auto* other = static_cast<const CMicrofacetSpecularBSDFNode*>(_other);
+            return ndf==other->ndf && shadowing==other->shadowing && alpha_u==other->alpha_u && alpha_v==other->alpha_v;
+        }
+
         void setSmooth(E_NDF _ndf = ENDF_GGX)
         {
             ndf = _ndf;
@@ -579,6 +764,21 @@ public:
     {
         CMicrofacetDiffuseBxDFBase(E_TYPE t) : CBSDFNode(t) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CBSDFNode::hashContents();
+            hashValue(seed, alpha_u);
+            hashValue(seed, alpha_v);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            if (!CBSDFNode::equalContents(_other))
+                return false;
+            auto* other = static_cast<const CMicrofacetDiffuseBxDFBase*>(_other);
+            return alpha_u==other->alpha_u && alpha_v==other->alpha_v;
+        }
+
         void setSmooth()
         {
             alpha_u.source = EPS_CONSTANT;
@@ -593,31 +793,149 @@ public:
     {
         CMicrofacetDiffuseBSDFNode() : CMicrofacetDiffuseBxDFBase(ET_MICROFACET_DIFFUSE) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CMicrofacetDiffuseBxDFBase::hashContents();
+            hashValue(seed, reflectance);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return CMicrofacetDiffuseBxDFBase::equalContents(_other) && reflectance==static_cast<const CMicrofacetDiffuseBSDFNode*>(_other)->reflectance;
+        }
+
         SParameter<color_t> reflectance = color_t(1.f);
     };
     struct CMicrofacetDifftransBSDFNode : CMicrofacetDiffuseBxDFBase
     {
         CMicrofacetDifftransBSDFNode() : CMicrofacetDiffuseBxDFBase(ET_MICROFACET_DIFFTRANS) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CMicrofacetDiffuseBxDFBase::hashContents();
+            hashValue(seed, transmittance);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return CMicrofacetDiffuseBxDFBase::equalContents(_other) && transmittance==static_cast<const CMicrofacetDifftransBSDFNode*>(_other)->transmittance;
+        }
+
         SParameter<color_t> transmittance = color_t(0.5f);
     };
     struct CMicrofacetCoatingBSDFNode : CMicrofacetSpecularBSDFNode
     {
         CMicrofacetCoatingBSDFNode() : CMicrofacetSpecularBSDFNode(ET_MICROFACET_COATING) {}
 
+        size_t hashContents() const override
+        {
+            size_t seed = CMicrofacetSpecularBSDFNode::hashContents();
+            hashValue(seed, thicknessSigmaA);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return CMicrofacetSpecularBSDFNode::equalContents(_other) && thicknessSigmaA==static_cast<const CMicrofacetCoatingBSDFNode*>(_other)->thicknessSigmaA;
+        }
+
         SParameter<color_t> thicknessSigmaA;
     };
     struct CMicrofacetDielectricBSDFNode : CMicrofacetSpecularBSDFNode
     {
         CMicrofacetDielectricBSDFNode() : CMicrofacetSpecularBSDFNode(ET_MICROFACET_DIELECTRIC) {}
+
+        size_t hashContents() const override
+        {
+            size_t seed = CMicrofacetSpecularBSDFNode::hashContents();
+            core::hash_combine(seed, thin);
+            return seed;
+        }
+        bool equalContents(const INode* _other) const override
+        {
+            return CMicrofacetSpecularBSDFNode::equalContents(_other) && thin==static_cast<const CMicrofacetDielectricBSDFNode*>(_other)->thin;
+        }
         bool thin = false;
     };
 
+private:
+    static void computeMerkleHash(INode* node)
+    {
+        size_t seed = node->hashContents();
+        for (auto* child : node->children)
+        {
+            computeMerkleHash(child);
+            core::hash_combine(seed, child->merkleHash);
+        }
+        node->merkleHash = seed;
+    }
+    static bool equalSubtrees(const INode* lhs, const INode* rhs)
+    {
+        if (lhs==rhs)
+            return true;
+        if (lhs->merkleHash!=rhs->merkleHash || !lhs->equalContents(rhs))
+            return false;
+        for (size_t i = 0ull; i < lhs->children.count; ++i)
+        if (!equalSubtrees(lhs->children[i], rhs->children[i]))
+            return false;
+        return true;
+    }
+    // post-order, so `f` may destroy the node
+    template <class F>
+    static void forEachInSubtree(INode* node, F&& f)
+    {
+        for (auto* child : node->children)
+            forEachInSubtree(child, f);
+        f(node);
+    }
+
+    bool isInterned(const INode* node) const
+    {
+        auto found = internedNodes.find(node->merkleHash);
+        return found!=internedNodes.end() && std::find(found->second.begin(), found->second.end(), node)!=found->second.end();
+    }
+
+    // top-down so that a whole subtree gets reused or none of it
+    INode* intern(INode* node, core::unordered_set<const INode*>& usedInRoot)
+    {
+        auto& candidates = internedNodes[node->merkleHash];
+        for (INode* candidate : candidates)
+        {
+            if (!equalSubtrees(candidate, node))
+                continue;
+
+            bool usedAlready = false;
+            forEachInSubtree(candidate, [&](INode* n) { usedAlready = usedAlready || usedInRoot.find(n)!=usedInRoot.end(); });
+            if (usedAlready)
+                continue;
+
+            forEachInSubtree(candidate, [&](INode* n) { usedInRoot.insert(n); });
+            // the duplicate will not be reachable from any root, so the destructor of IR would never see it
+            if (candidate!=node)
+            forEachInSubtree(node, [this](INode* n) {
+                if (n->deinited || isInterned(n))
+                    return;
+                n->~INode();
+                n->deinited = true;
+            });
+            return candidate;
+        }
+
+        if (std::find(candidates.begin(), candidates.end(), node) == candidates.end())
+            candidates.push_back(node);
+        usedInRoot.insert(node);
+        for (auto& child : node->children)
+            child = intern(child, usedInRoot);
+        return node;
+    }
+
+    core::unordered_map<size_t, core::vector<INode*>> internedNodes;
+
+public:
     SBackingMemManager memMgr;
     core::vector<INode*> roots;
 
     core::vector<INode*> tmp;
-    uint32_t tmpSize = 0u;
+    size_t tmpSize = 0u;
 };
 
 }
@@ -9,11 +9,14 @@
 #include <iostream>
 #include <limits>
 #include <cmath>
+#include <shared_mutex>
+#include <mutex>
 
 #include "parallel-hashmap/parallel_hashmap/phmap_dump.h"
 
 
 #include "nbl/core/declarations.h"
+#include "nbl/core/execution.h"
 #include "vectorSIMD.h"
 
 #include "nbl/system/declarations.h"
@@ -261,10 +264,12 @@ class CDirQuantCacheBase : public impl::CDirQuantCacheBase
 		template<E_FORMAT CacheFormat>
 		using cache_type_t = typename cache_type<CacheFormat>::type;
 
+		//! All public methods are thread-safe, every format's cache is guarded by its own reader-writer lock
 		template<E_FORMAT CacheFormat>
 		inline void insertIntoCache(const Key& key, const value_type_t<CacheFormat>& value)
 		{
-			std::get<cache_type_t<CacheFormat>>(cache).insert(std::make_pair(key,value));		
+			std::unique_lock lock(getLock<CacheFormat>());
+			std::get<cache_type_t<CacheFormat>>(cache).insert(std::make_pair(key,value));
 		}
 
 		//!
@@ -275,6 +280,7 @@ class CDirQuantCacheBase : public impl::CDirQuantCacheBase
 			if (!validateSerializedCache<CacheFormat>(buffer))
 				return false;
 
+			std::unique_lock lock(getLock<CacheFormat>());
 			auto& particularCache = std::get<cache_type_t<CacheFormat>>(cache);
 			cache_type_t<CacheFormat> backup;
 
@@ -329,7 +335,8 @@ class CDirQuantCacheBase : public impl::CDirQuantCacheBase
 			const uint64_t bufferSize = buffer.buffer.get()->getSize();
 			const uint64_t offset = buffer.offset;
 
-			if (bufferSize+offset>getSerializedCacheSizeInBytes<CacheFormat>())
+			std::shared_lock lock(getLock<CacheFormat>());
+			if (bufferSize+offset>getSerializedCacheSizeInBytes_impl<CacheFormat>(std::get<cache_type_t<CacheFormat>>(cache).capacity()))
 				return false;
 
 			CBufferPhmapOutputArchive buffWrap(buffer);
@@ -370,17 +377,39 @@ class CDirQuantCacheBase : public impl::CDirQuantCacheBase
 		template<E_FORMAT CacheFormat>
 		inline size_t getSerializedCacheSizeInBytes()
 		{
+			std::shared_lock lock(getLock<CacheFormat>());
 			return getSerializedCacheSizeInBytes_impl<CacheFormat>(std::get<cache_type_t<CacheFormat>>(cache).capacity());
 		}
 
 	protected:
 		std::tuple<cache_type_t<Formats>...> cache;
+		mutable std::array<std::shared_mutex,sizeof...(Formats)> cacheLocks;
+
+		template<E_FORMAT CacheFormat>
+		inline std::shared_mutex& getLock() const
+		{
+			constexpr E_FORMAT formats[] = {Formats...};
+			constexpr size_t index = std::find(formats,formats+sizeof...(Formats),CacheFormat)-formats;
+			static_assert(index<sizeof...(Formats),"Format not cached!");
+			return cacheLocks[index];
+		}
+
+		//! the cache only holds the absolute values, flips the quantized components back to where `value` was negative
+		template<E_FORMAT CacheFormat>
+		static inline value_type_t<CacheFormat> restoreSign(const value_type_t<CacheFormat>& quantized, const core::vectorSIMDf& value)
+		{
+			constexpr auto quantizationBits = quantization_bits_v<CacheFormat>;
+			const auto negativeMask = value < core::vectorSIMDf(0.0f);
+
+			const core::vectorSIMDu32 xorflag((0x1u<<(quantizationBits+1u))-1u);
+			auto restoredAsVec = quantized.getValue()^core::mix(core::vectorSIMDu32(0u),xorflag,negativeMask);
+			restoredAsVec += core::mix(core::vectorSIMDu32(0u),core::vectorSIMDu32(1u),negativeMask);
+			return value_type_t<CacheFormat>(restoredAsVec&xorflag);
+		}
 		
 		template<uint32_t dimensions, E_FORMAT CacheFormat>
 		value_type_t<CacheFormat> quantize(const core::vectorSIMDf& value)
 		{
-			const auto negativeMask = value < core::vectorSIMDf(0.0f);
-
 			const core::vectorSIMDf absValue = abs(value);
 			const auto key = Key(absValue);
 
@@ -388,22 +417,78 @@ class CDirQuantCacheBase : public impl::CDirQuantCacheBase
 			value_type_t<CacheFormat> quantized;
 			{
 				auto& particularCache = std::get<cache_type_t<CacheFormat>>(cache);
-				auto found = particularCache.find(key);
-				if (found != particularCache.end() && (found->first == key))
-					quantized = found->second;
-				else
+				bool found;
 				{
+					std::shared_lock lock(getLock<CacheFormat>());
+					auto it = particularCache.find(key);
+					found = it!=particularCache.end();
+					if (found)
+						quantized = it->second;
+				}
+				if (!found)
+				{
+					// the expensive search runs outside the lock, if another thread raced us to the same key it computed the same value
 					const core::vectorSIMDf fit = findBestFit<dimensions,quantizationBits>(absValue);
 
 					quantized = core::vectorSIMDu32(core::abs(fit));
 					insertIntoCache<CacheFormat>(key,quantized);
 				}
 			}
+			return restoreSign<CacheFormat>(quantized,value);
+		}
+
+		//! Same result as calling `quantize` on every element, but takes each lock only once and runs the best fit search for all the distinct misses in parallel
+		template<uint32_t dimensions, E_FORMAT CacheFormat>
+		void quantizeBatch(const core::vectorSIMDf* values, value_type_t<CacheFormat>* out, const size_t count)
+		{
+			constexpr auto quantizationBits = quantization_bits_v<CacheFormat>;
+			auto& particularCache = std::get<cache_type_t<CacheFormat>>(cache);
+
+			struct SMiss
+			{
+				Key key;
+				core::vectorSIMDf absValue;
+				value_type_t<CacheFormat> quantized;
+			};
+			core::vector<SMiss> misses;
+			core::unordered_map<Key,uint32_t,Hash> missIndex;
+			// output slots which need to be filled from `misses`, pairs of (element,miss)
+			core::vector<std::pair<size_t,uint32_t>> pending;
+			{
+				std::shared_lock lock(getLock<CacheFormat>());
+				for (size_t i=0ull; i<count; i++)
+				{
+					const core::vectorSIMDf absValue = abs(values[i]);
+					const auto key = Key(absValue);
+					auto found = particularCache.find(key);
+					if (found!=particularCache.end())
+					{
+						out[i] = found->second;
+						continue;
+					}
+					auto inserted = missIndex.emplace(key,static_cast<uint32_t>(misses.size()));
+					if (inserted.second)
+						misses.push_back({key,absValue,{}});
+					pending.emplace_back(i,inserted.first->second);
+				}
+			}
 
-			const core::vectorSIMDu32 xorflag((0x1u<<(quantizationBits+1u))-1u);
-			auto restoredAsVec = quantized.getValue()^core::mix(core::vectorSIMDu32(0u),xorflag,negativeMask);
-			restoredAsVec += core::mix(core::vectorSIMDu32(0u),core::vectorSIMDu32(1u),negativeMask);
-			return value_type_t<CacheFormat>(restoredAsVec&xorflag);
+			if (!misses.empty())
+			{
+				std::for_each(core::execution::par_unseq,misses.begin(),misses.end(),[](SMiss& miss)->void
+				{
+					miss.quantized = core::vectorSIMDu32(core::abs(findBestFit<dimensions,quantizationBits>(miss.absValue)));
+				});
+				std::unique_lock lock(getLock<CacheFormat>());
+				particularCache.reserve(particularCache.size()+misses.size());
+				for (const auto& miss : misses)
+					particularCache.insert(std::make_pair(miss.key,miss.quantized));
+			}
+			for (const auto& slot : pending)
+				out[slot.first] = misses[slot.second].quantized;
+
+			for (size_t i=0ull; i<count; i++)
+				out[i] = restoreSign<CacheFormat>(out[i],values[i]);
 		}
 
 		template<uint32_t dimensions, uint32_t quantizationBits>
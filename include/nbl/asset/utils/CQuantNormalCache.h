@@ -61,6 +61,16 @@ class CQuantNormalCache : public CDirQuantCacheBase<impl::VectorUV,impl::QuantNo
 			normal.makeSafe3D();
 			return Base::quantize<3u,CacheFormat>(normal);
 		}
+
+		//!
+		template<E_FORMAT CacheFormat>
+		void quantizeBatch(const std::span<const core::vectorSIMDf> normals, value_type_t<CacheFormat>* out)
+		{
+			core::vector<core::vectorSIMDf> safeNormals(normals.begin(),normals.end());
+			for (auto& normal : safeNormals)
+				normal.makeSafe3D();
+			Base::quantizeBatch<3u,CacheFormat>(safeNormals.data(),out,safeNormals.size());
+		}
 };
 
 }
@@ -64,6 +64,13 @@ class CQuantQuaternionCache : public CDirQuantCacheBase<impl::Projection,impl::Q
 		{
 			return Base::quantize<4u,CacheFormat>(reinterpret_cast<const core::vectorSIMDf&>(quat));
 		}
+
+		//!
+		template<E_FORMAT CacheFormat>
+		void quantizeBatch(const std::span<const core::quaternion> quats, value_type_t<CacheFormat>* out)
+		{
+			Base::quantizeBatch<4u,CacheFormat>(reinterpret_cast<const core::vectorSIMDf*>(quats.data()),out,quats.size());
+		}
 };
 
 }
@@ -70,11 +70,20 @@ class NBL_API2 IMeshManipulator : public virtual core::IReferenceCounted
 		{
 			uint32_t indexOffset;									//offset of the vertex into index buffer
 			uint32_t hash;											//
-			float wage;												//angle wage of the vertex
+			float wage;												//angle or area wage of the vertex
 			core::vector4df_SIMD position;							//position of the vertex in 3D space
 			core::vector3df_SIMD parentTriangleFaceNormal;			//
 		};
+		//! Gets called concurrently from many threads, must not modify the meshbuffer
 		typedef std::function<bool(const IMeshManipulator::SSNGVertexData&, const IMeshManipulator::SSNGVertexData&, ICPUMeshBuffer*)> VxCmpFunction;
+		//! How the face normals of the triangles sharing a vertex contribute to its smooth normal
+		enum E_NORMAL_WEIGHTING : uint8_t
+		{
+			//! by the triangle's interior angle at the vertex
+			ENW_ANGLE,
+			//! by the triangle's area
+			ENW_AREA
+		};
 
         //! Compares two attributes of floating point types in accordance with passed error metric.
         /**
@@ -476,7 +485,8 @@ class NBL_API2 IMeshManipulator : public virtual core::IReferenceCounted
 				{ 
 					static constexpr float cosOf45Deg = 0.70710678118f;
 					return dot(v0.parentTriangleFaceNormal,v1.parentTriangleFaceNormal)[0] > cosOf45Deg;
-				});
+				},
+				E_NORMAL_WEIGHTING weighting = ENW_ANGLE);
 
 
 		//! Creates a copy of a mesh with vertices welded
@@ -499,6 +509,84 @@ class NBL_API2 IMeshManipulator : public virtual core::IReferenceCounted
 		*/
 		static void requantizeMeshBuffer(ICPUMeshBuffer* _meshbuffer, const SErrorMetric* _errMetric);
 
+		//! Limits for `createMeshlets`, local indices are 8bit so `maxVertices` cannot exceed 256
+		struct SMeshletParams
+		{
+			SMeshletParams(uint32_t _maxVertices=64u, uint32_t _maxTriangles=124u) : maxVertices(_maxVertices), maxTriangles(_maxTriangles) {}
+
+			uint32_t maxVertices;
+			uint32_t maxTriangles;
+		};
+		//! A cluster of at most `SMeshletParams::maxTriangles` triangles referencing at most `SMeshletParams::maxVertices` vertices
+		struct SMeshlet
+		{
+			uint32_t vertexOffset; //!< first entry in `SMeshletData::vertices`
+			uint32_t triangleOffset; //!< first byte in `SMeshletData::triangles`, 3 local indices per triangle
+			uint32_t vertexCount;
+			uint32_t triangleCount;
+		};
+		//! Culling data of a meshlet
+		/**
+			The whole cluster is backfacing and can be culled when `dot(normalize(coneApex-cameraPosition),coneAxis) >= coneCutoff`.
+			Clusters whose normals spread over more than a hemisphere get a zero axis and a cutoff of 1, so they never pass the test.
+		*/
+		struct SMeshletBounds
+		{
+			core::vectorSIMDf boundingSphere; //!< center in xyz, radius in w
+			core::vectorSIMDf coneApex;
+			core::vectorSIMDf coneAxis;
+			float coneCutoff; //!< sine of the normal cone's half-angle
+		};
+		//! Output of `createMeshlets`, `meshlets` and `bounds` are parallel arrays
+		struct SMeshletData
+		{
+			core::vector<SMeshlet> meshlets;
+			core::vector<SMeshletBounds> bounds;
+			core::vector<uint32_t> vertices; //!< indices of the original meshbuffer's vertices
+			core::vector<uint8_t> triangles; //!< triangles as local indices into the meshlet's range of `vertices`
+		};
+
+		//! Splits a triangle meshbuffer into meshlets in index order, run it after vertex cache optimization for tight clusters.
+		/** Works on lists, strips and fans, indexed or not. Returns empty data for non-triangle topologies or invalid limits. */
+		static SMeshletData createMeshlets(const ICPUMeshBuffer* meshbuffer, const SMeshletParams& params=SMeshletParams());
+		//! Meshlets of every meshbuffer of the mesh, in the order of `getMeshBuffers()`, the meshbuffers are processed in parallel.
+		static core::vector<SMeshletData> createMeshlets(const ICPUMesh* mesh, const SMeshletParams& params=SMeshletParams());
+
+		//! Settings of `createLoDChain`
+		struct SLoDChainParams
+		{
+			SLoDChainParams(uint32_t _levelCount=4u, float _triangleRatio=0.5f, float _maxError=INFINITY, bool _lockBorders=true, float _minNormalDot=0.25f) :
+				levelCount(_levelCount), triangleRatio(_triangleRatio), maxError(_maxError), lockBorders(_lockBorders), minNormalDot(_minNormalDot) {}
+
+			uint32_t levelCount; //!< number of reduced levels to generate, the chain stops early once the simplifier cannot make progress
+			float triangleRatio; //!< every level targets this fraction of the previous level's triangles
+			float maxError; //!< collapses whose error (in the same units as `SLoDLevel::error`) would exceed this are not performed
+			bool lockBorders; //!< keep the vertices on open edges in place, needed to avoid cracks between meshbuffers sharing a border
+			float minNormalDot; //!< collapses rotating any triangle's normal further than this cosine are rejected
+		};
+		//! One level of a LoD chain, the meshbuffer shares the vertex data, pipeline and descriptor set with the input
+		struct SLoDLevel
+		{
+			//! Distance at which the level may be switched to, given the tolerable object space error per unit of view distance (i.e. pixel error over focal length in pixels)
+			inline float getSwitchDistance(const float errorPerUnitDistance) const
+			{
+				return error/errorPerUnitDistance;
+			}
+
+			core::smart_refctd_ptr<ICPUMeshBuffer> meshbuffer;
+			float error; //!< square root of the largest area weighted mean quadric error of the collapses, an object space distance estimate (not a bound) usable for `scene::ILevelOfDetailLibrary` switch distances
+		};
+
+		//! Quadric error metric (Garland-Heckbert) edge collapse simplification producing successively coarser index buffers.
+		/**
+			Only vertices of the input are kept, so attributes stay exact. Vertices with the same position but different attributes (UV/normal seams)
+			are never moved, the borders too when `SLoDChainParams::lockBorders` is set. Works on triangle lists, strips and fans, the levels are lists.
+			The first level of the chain is the first reduced one, the original meshbuffer is not included.
+		*/
+		static core::vector<SLoDLevel> createLoDChain(const ICPUMeshBuffer* meshbuffer, const SLoDChainParams& params=SLoDChainParams());
+		//! Batch version of `createLoDChain` for a whole scene, the meshbuffers are simplified in parallel.
+		static core::vector<core::vector<SLoDLevel>> createLoDChains(const core::SRange<const ICPUMeshBuffer* const>& meshbuffers, const SLoDChainParams& params=SLoDChainParams());
+
         //! Creates a 32bit index buffer for a mesh with primitive types changed to list types
         /**#
 		@param _newPrimitiveType
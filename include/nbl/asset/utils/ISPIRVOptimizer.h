@@ -43,6 +43,8 @@ class ISPIRVOptimizer final : public core::IReferenceCounted
         core::smart_refctd_ptr<ICPUBuffer> optimize(const uint32_t* _spirv, uint32_t _dwordCount, system::logger_opt_ptr logger) const;
         core::smart_refctd_ptr<ICPUBuffer> optimize(const ICPUBuffer* _spirv, system::logger_opt_ptr logger) const;
 
+        inline std::span<const E_OPTIMIZER_PASS> getPasses() const {return {m_passes.begin(),m_passes.size()};}
+
     protected:
         const std::initializer_list<E_OPTIMIZER_PASS> m_passes;
 };
@@ -6,6 +6,11 @@
 
 #include "nbl/core/declarations.h"
 #include "nbl/system/declarations.h"
+#include "nbl/core/xxHash256.h"
+
+#include <shared_mutex>
+#include <atomic>
+#include <optional>
 
 #include "nbl/system/IFile.h"
 #include "nbl/system/ISystem.h"
@@ -30,6 +35,8 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 				{
 					system::path absolutePath = {};
 					std::string contents = {};
+					// xxHash256 of `contents`, only filled in by `CIncludeFinder`
+					std::array<uint64_t,4> hash = {};
 
 					explicit inline operator bool() const {return !absolutePath.empty();}
 				};
@@ -65,9 +72,22 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 				core::smart_refctd_ptr<system::ISystem> m_system;
 		};
 
+		//! Resolves includes through generators, search paths and the filesystem. Thread-safe as long as no search paths or generators are being added.
+		// Every resolved include is cached together with its hash and the modification time of the file it came from,
+		// repeated lookups only check the time and reload the file if it changed. Generated and builtin includes never go stale.
 		class NBL_API2 CIncludeFinder : public core::IReferenceCounted
 		{
 			public:
+				//! An edge of the include graph of a compiled source, enough to redo the lookup and tell whether the result changed
+				struct SDependency
+				{
+					system::path requestingSourceDir;
+					std::string includeName;
+					system::path absolutePath;
+					std::array<uint64_t,4> hash;
+					bool standardInclude;
+				};
+
 				CIncludeFinder(core::smart_refctd_ptr<system::ISystem>&& system);
 
 				// ! includes within <>
@@ -86,7 +106,17 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 
 				void addGenerator(const core::smart_refctd_ptr<IIncludeGenerator>& generator);
 
+				//! Whether the include would still resolve to the same contents, so anything compiled with it is still valid
+				bool isUpToDate(const SDependency& dependency) const;
+
+				//! Forgets all resolved includes, needed when a new file could shadow an already resolved one
+				void clearCache();
+
 			protected:
+				IIncludeLoader::found_t getCachedInclude(const bool standard, const system::path& requestingSourceDir, const std::string& includeName) const;
+				IIncludeLoader::found_t resolveIncludeStandard(const system::path& requestingSourceDir, const std::string& includeName) const;
+				IIncludeLoader::found_t resolveIncludeRelative(const system::path& requestingSourceDir, const std::string& includeName) const;
+
 				IIncludeLoader::found_t trySearchPaths(const std::string& includeName) const;
 
 				IIncludeLoader::found_t tryIncludeGenerators(const std::string& includeName) const;
@@ -100,6 +130,18 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 				std::vector<LoaderSearchPath> m_loaders;
 				std::vector<core::smart_refctd_ptr<IIncludeGenerator>> m_generators;
 				core::smart_refctd_ptr<CFileSystemIncludeLoader> m_defaultFileSystemLoader;
+
+				struct SCachedInclude
+				{
+					system::path absolutePath;
+					std::string contents;
+					std::array<uint64_t,4> hash;
+					// empty when the include doesn't come from a file on disk
+					std::optional<std::filesystem::file_time_type> modificationTime;
+				};
+				mutable std::shared_mutex m_cacheMutex;
+				// keyed by the kind of include, the requesting directory and the include name
+				mutable core::unordered_map<std::string,SCachedInclude> m_cache;
 		};
 
 		enum class E_SPIRV_VERSION : uint32_t
@@ -113,6 +155,75 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 			ESV_1_6 = 0x010600u,
 		};
 
+		//! Content addressed store of compiled SPIR-V which can be shared between compilers and threads, and persisted to a file.
+		// The key is built from the fully preprocessed source, so the contents of every include and the defines are a part of it,
+		// together with the stage, target SPIR-V version, debug info flags, optimizer passes and compiler specific arguments.
+		class NBL_API2 CCache final : public core::IReferenceCounted
+		{
+			public:
+				using hash_t = std::array<uint64_t,4>;
+				// bump whenever the key derivation, file layout or the bundled compilers change
+				constexpr static inline uint32_t VERSION = 1u;
+
+				struct SStatistics
+				{
+					uint64_t hits = 0ull;
+					uint64_t misses = 0ull;
+					uint64_t insertions = 0ull;
+				};
+
+				CCache() = default;
+
+				//! Returns a copy of the cached SPIR-V or nullptr, counts a hit or a miss. Thread-safe.
+				core::smart_refctd_ptr<ICPUBuffer> find(const hash_t& key) const;
+				//! Stores a copy of `spirv`, the first insertion of a key wins. Thread-safe.
+				void insert(const hash_t& key, const ICPUBuffer* spirv);
+
+				inline SStatistics getStatistics() const {return {m_hits.load(),m_misses.load(),m_insertions.load()};}
+				size_t getEntryCount() const;
+
+				//! Replaces the previously loaded entries with the ones in a file written by `save`, inserted entries stay.
+				// A mapped file gets used in place, its index is binary searched and hits copy straight out of the mapping.
+				bool load(core::smart_refctd_ptr<system::IFile>&& file);
+				//! Writes out all entries, loaded and inserted. Don't save over the file this cache has loaded from.
+				bool save(system::IFile* file) const;
+
+			private:
+				struct SHeader
+				{
+					uint32_t magic;
+					uint32_t version;
+					uint64_t entryCount;
+				};
+				//! the index is sorted by key and the blob offsets are relative to the end of the index
+				struct SIndexEntry
+				{
+					hash_t key;
+					uint64_t offset;
+					uint64_t size;
+				};
+				constexpr static inline uint32_t Magic = 0x4843534eu; // "NSCH"
+
+				struct KeyHash
+				{
+					inline size_t operator()(const hash_t& key) const {return key[0];}
+				};
+
+				const SIndexEntry* findLoaded(const hash_t& key) const;
+
+				mutable std::shared_mutex m_mutex;
+				core::unordered_map<hash_t,core::smart_refctd_ptr<ICPUBuffer>,KeyHash> m_inserted;
+				// whatever backs the loaded index and blobs, the file if it was mapped or a copy of its contents
+				core::smart_refctd_ptr<system::IFile> m_loadedFile;
+				core::vector<uint8_t> m_loadedCopy;
+				std::span<const SIndexEntry> m_loadedIndex;
+				const uint8_t* m_loadedBlobs = nullptr;
+
+				mutable std::atomic<uint64_t> m_hits = 0ull;
+				mutable std::atomic<uint64_t> m_misses = 0ull;
+				std::atomic<uint64_t> m_insertions = 0ull;
+		};
+
 		IShaderCompiler(core::smart_refctd_ptr<system::ISystem>&& system);
 
 		struct SPreprocessorOptions
@@ -126,6 +237,8 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 				std::string_view definition;
 			};
 			std::span<const SMacroDefinition> extraDefines = {};
+			// Optional, if not nullptr every #include resolved by the `includeFinder` gets appended to it in the order they're opened
+			core::vector<CIncludeFinder::SDependency>* dependencies = nullptr;
 		};
 
 		// https://github.com/microsoft/DirectXShaderCompiler/blob/main/docs/SPIR-V.rst#debugging
@@ -154,6 +267,7 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 				@includeFinder Optional parameter; if not nullptr, it will resolve the includes in the code
 				@maxSelfInclusionCount used only when includeFinder is not nullptr
 				@extraDefines adds extra defines to the shader before compilation
+			@cache Optional parameter; if not nullptr, compilation results are looked up in and added to it
 		*/
 		struct SCompilerOptions
 		{
@@ -162,6 +276,7 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 			const ISPIRVOptimizer* spirvOptimizer = nullptr;
 			core::bitflag<E_DEBUG_INFO_FLAGS> debugInfoFlags = core::bitflag<E_DEBUG_INFO_FLAGS>(E_DEBUG_INFO_FLAGS::EDIF_SOURCE_BIT) | E_DEBUG_INFO_FLAGS::EDIF_TOOL_BIT;
 			SPreprocessorOptions preprocessorOptions = {};
+			CCache* cache = nullptr;
 
 			void setCommonData(const SCompilerOptions& opt)
 			{
@@ -299,6 +414,9 @@ class NBL_API2 IShaderCompiler : public core::IReferenceCounted
 
 		virtual void insertIntoStart(std::string& code, std::ostringstream&& ins) const = 0;
 
+		//! `compilerArguments` are any extra bytes which affect the compiler output, such as the command line
+		static CCache::hash_t getCacheKey(const IShader::E_CONTENT_TYPE contentType, const std::string_view preprocessedCode, const IShader::E_SHADER_STAGE stage, const SCompilerOptions& options, const std::string_view compilerArguments={});
+
 		core::smart_refctd_ptr<system::ISystem> m_system;
 	private:
 		core::smart_refctd_ptr<CIncludeFinder> m_defaultIncludeFinder;
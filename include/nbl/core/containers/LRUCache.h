@@ -215,6 +215,22 @@ class LRUCache : protected impl::LRUCacheBase<Key,Value,MapHash,MapEquals>
 				return nullptr;
 		}
 
+		//number of elements currently in the cache
+		inline size_t getSize() const { return m_shortcut_map.size(); }
+
+		//remove the least recently used element after passing it to `evictCallback`, returns false if the cache was empty
+		template<std::invocable<Value&> EvictionCallback>
+		inline bool popLeastRecentlyUsed(EvictionCallback&& evictCallback)
+		{
+			const uint32_t nodeAddr = base_t::m_list.getLastAddress();
+			if (nodeAddr==invalid_iterator)
+				return false;
+			evictCallback(base_t::m_list.get(nodeAddr)->data.second);
+			m_shortcut_map.erase(nodeAddr);
+			base_t::m_list.popBack();
+			return true;
+		}
+
 		//remove element at key if present
 		inline void erase(const Key& key)
 		{
@@ -8,94 +8,179 @@
 #include <cstdint>
 #include <cstring>
 #include <array>
+#include <algorithm>
+#include <bit>
+#include <cassert>
 
 namespace nbl::core
 {
-constexpr std::array<uint64_t, 4> XXHash_256(const uint8_t* input, const size_t len)
+//! Incremental form of `XXHash_256`, feeding the same bytes in any number of `update` calls gives the same hash as the one-shot function.
+/** The total length seeds the lanes and decides where the 128 byte block loop hands over to the 32 byte one, so it needs to be known upfront.
+Whole blocks are hashed straight out of the caller's memory, only blocks straddling two `update` calls and the tail get copied into the state.
+*/
+class XXHash256
 {
-#define _rotl(x,r) ((x << r) | (x >> (64 - r)))
-    constexpr uint64_t PRIME = 11400714819323198393ULL;
+    public:
+        using hash_t = std::array<uint64_t,4>;
 
-    uint64_t out[4] = { 0,0,0,0 }; // must be initialized to 0s
+        constexpr static inline uint64_t PRIME = 11400714819323198393ULL;
+        constexpr static inline size_t SmallBlockSize = 4*sizeof(uint64_t);
+        constexpr static inline size_t BigBlockSize = 4*SmallBlockSize;
+
+        constexpr explicit XXHash256(const size_t totalLength) : m_length(totalLength)
+        {
+            for (auto& v : m_lanes)
+                v = totalLength*PRIME;
+            if (totalLength<SmallBlockSize)
+                return;
+            // Set the big loop limit early enough, so the well-mixing small loop can be executed twice after it
+            constexpr size_t BigLoopReqLen = BigBlockSize+2*SmallBlockSize;
+            if (totalLength>BigLoopReqLen)
+                m_bigLoopEnd = roundUp(totalLength-BigLoopReqLen,BigBlockSize);
+            const size_t smallLoopLimit = totalLength-SmallBlockSize;
+            m_smallLoopEnd = m_bigLoopEnd<smallLoopLimit ? (m_bigLoopEnd+roundUp(smallLoopLimit-m_bigLoopEnd,SmallBlockSize)):m_bigLoopEnd;
+        }
+
+        constexpr XXHash256& update(const uint8_t* data, size_t size)
+        {
+            assert(getConsumedSize()+size<=m_length);
+            while (size)
+            {
+                const size_t blockSize = m_processed<m_bigLoopEnd ? BigBlockSize:(m_processed<m_smallLoopEnd ? SmallBlockSize:0ull);
+                // past the block loops, whatever is left is the tail
+                if (!blockSize)
+                {
+                    std::copy_n(data,size,m_buffer.data()+m_buffered);
+                    m_buffered += size;
+                    break;
+                }
+                // the loops end on block boundaries, so a partial block never crosses from one loop into the other
+                if (m_buffered || size<blockSize)
+                {
+                    const size_t toCopy = std::min(blockSize-m_buffered,size);
+                    std::copy_n(data,toCopy,m_buffer.data()+m_buffered);
+                    m_buffered += toCopy;
+                    data += toCopy;
+                    size -= toCopy;
+                    if (m_buffered==blockSize)
+                    {
+                        m_buffered = 0ull;
+                        processBlocks(m_buffer.data(),blockSize,1ull);
+                    }
+                }
+                else
+                {
+                    const size_t loopEnd = blockSize==BigBlockSize ? m_bigLoopEnd:m_smallLoopEnd;
+                    const size_t blockCount = std::min(size,loopEnd-m_processed)/blockSize;
+                    processBlocks(data,blockSize,blockCount);
+                    data += blockCount*blockSize;
+                    size -= blockCount*blockSize;
+                }
+            }
+            return *this;
+        }
+        inline XXHash256& update(const void* data, const size_t size)
+        {
+            return update(reinterpret_cast<const uint8_t*>(data),size);
+        }
 
-    const uint8_t* p = input;
-    const uint8_t* const bEnd = p + len;
+        //! Only valid once exactly `totalLength` bytes went through `update`
+        constexpr hash_t finalize() const
+        {
+            assert(getConsumedSize()==m_length);
+            hash_t out = { 0,0,0,0 }; // must be initialized to 0s
+            for (size_t i=0; i<m_buffered; ++i)
+                out[i/8] |= static_cast<uint64_t>(m_buffer[i])<<((i%8)*8);
+            for (auto i=0; i<4; i++)
+                out[i] += m_lanes[i];
+            return out;
+        }
 
-    uint64_t v1 = len * PRIME;
-    uint64_t v2 = v1;
-    uint64_t v3 = v1;
-    uint64_t v4 = v1;
+        //
+        constexpr size_t getConsumedSize() const {return m_processed+m_buffered;}
+        constexpr size_t getTotalLength() const {return m_length;}
 
-    constexpr size_t small_loop_step = 4 * sizeof(uint64_t);
-    if (len >= small_loop_step)
-    {
-        const uint8_t* const small_loop_limit = bEnd - small_loop_step;
+    private:
+        constexpr static size_t roundUp(const size_t x, const size_t multiple) {return ((x+multiple-1ull)/multiple)*multiple;}
 
-        constexpr auto getU64 = [](const uint8_t* in)
+        constexpr static uint64_t getU64(const uint8_t* in)
         {
+            // the byte-by-byte assembly is only there to be endian independent and usable in constant evaluation,
+            // at runtime on little endian a plain unaligned load is the same thing and cuts the lane loop down to 8 loads per 64 bytes
+            if constexpr (std::endian::native==std::endian::little)
+            if (!std::is_constant_evaluated())
+            {
+                uint64_t u64;
+                std::memcpy(&u64,in,sizeof(u64));
+                return u64;
+            }
             uint64_t u64 = 0;
-
             for (int i = 0; i < 8; ++i)
                 u64 |= static_cast<uint64_t>(in[i]) << (i * 8);
             return u64;
-        };
+        }
 
-        const size_t big_loop_step = 4 * 4 * sizeof(uint64_t);
-        // Set the big loop limit early enough, so the well-mixing small loop can be executed twice after it
-        const size_t big_loop_req_len = big_loop_step + 2 * small_loop_step;
-        if (len >= big_loop_req_len)
+        constexpr void processBlocks(const uint8_t* p, const size_t blockSize, const size_t blockCount)
         {
-            const uint8_t* const big_loop_limit = bEnd - big_loop_req_len;
-            while (p < big_loop_limit)
+            auto v1 = m_lanes[0];
+            auto v2 = m_lanes[1];
+            auto v3 = m_lanes[2];
+            auto v4 = m_lanes[3];
+            // The lanes feed into each other through the multiply every 32 bytes and x86 has no 64bit vector multiply below AVX-512,
+            // keeping them in 4 scalar registers lets the 4 independent rotate+add chains run in parallel which is already load-bound.
+            if (blockSize==BigBlockSize)
+            for (size_t i=0; i<blockCount; i++)
             {
-                v1 = _rotl(v1, 29) + getU64(p); p += sizeof(uint64_t);
-                v2 = _rotl(v2, 31) + getU64(p); p += sizeof(uint64_t);
-                v3 = _rotl(v3, 33) + getU64(p); p += sizeof(uint64_t);
-                v4 = _rotl(v4, 35) + getU64(p); p += sizeof(uint64_t);
+                v1 = std::rotl(v1,29)+getU64(p); p += sizeof(uint64_t);
+                v2 = std::rotl(v2,31)+getU64(p); p += sizeof(uint64_t);
+                v3 = std::rotl(v3,33)+getU64(p); p += sizeof(uint64_t);
+                v4 = std::rotl(v4,35)+getU64(p); p += sizeof(uint64_t);
                 v1 += v2 *= PRIME;
-                v1 = _rotl(v1, 29) + getU64(p); p += sizeof(uint64_t);
-                v2 = _rotl(v2, 31) + getU64(p); p += sizeof(uint64_t);
-                v3 = _rotl(v3, 33) + getU64(p); p += sizeof(uint64_t);
-                v4 = _rotl(v4, 35) + getU64(p); p += sizeof(uint64_t);
+                v1 = std::rotl(v1,29)+getU64(p); p += sizeof(uint64_t);
+                v2 = std::rotl(v2,31)+getU64(p); p += sizeof(uint64_t);
+                v3 = std::rotl(v3,33)+getU64(p); p += sizeof(uint64_t);
+                v4 = std::rotl(v4,35)+getU64(p); p += sizeof(uint64_t);
                 v2 += v3 *= PRIME;
-                v1 = _rotl(v1, 29) + getU64(p); p += sizeof(uint64_t);
-                v2 = _rotl(v2, 31) + getU64(p); p += sizeof(uint64_t);
-                v3 = _rotl(v3, 33) + getU64(p); p += sizeof(uint64_t);
-                v4 = _rotl(v4, 35) + getU64(p); p += sizeof(uint64_t);
+                v1 = std::rotl(v1,29)+getU64(p); p += sizeof(uint64_t);
+                v2 = std::rotl(v2,31)+getU64(p); p += sizeof(uint64_t);
+                v3 = std::rotl(v3,33)+getU64(p); p += sizeof(uint64_t);
+                v4 = std::rotl(v4,35)+getU64(p); p += sizeof(uint64_t);
                 v3 += v4 *= PRIME;
-                v1 = _rotl(v1, 29) + getU64(p); p += sizeof(uint64_t);
-                v2 = _rotl(v2, 31) + getU64(p); p += sizeof(uint64_t);
-                v3 = _rotl(v3, 33) + getU64(p); p += sizeof(uint64_t);
-                v4 = _rotl(v4, 35) + getU64(p); p += sizeof(uint64_t);
+                v1 = std::rotl(v1,29)+getU64(p); p += sizeof(uint64_t);
+                v2 = std::rotl(v2,31)+getU64(p); p += sizeof(uint64_t);
+                v3 = std::rotl(v3,33)+getU64(p); p += sizeof(uint64_t);
+                v4 = std::rotl(v4,35)+getU64(p); p += sizeof(uint64_t);
                 v4 += v1 *= PRIME;
             }
+            else
+            for (size_t i=0; i<blockCount; i++)
+            {
+                v1 = std::rotl(v1,29)+getU64(p); p += sizeof(uint64_t);
+                v2 += v1 *= PRIME;
+                v2 = std::rotl(v2,31)+getU64(p); p += sizeof(uint64_t);
+                v3 += v2 *= PRIME;
+                v3 = std::rotl(v3,33)+getU64(p); p += sizeof(uint64_t);
+                v4 += v3 *= PRIME;
+                v4 = std::rotl(v4,35)+getU64(p); p += sizeof(uint64_t);
+                v1 += v4 *= PRIME;
+            }
+            m_lanes = {v1,v2,v3,v4};
+            m_processed += blockSize*blockCount;
         }
 
-        while (p < small_loop_limit)
-        {
-            v1 = _rotl(v1, 29) + getU64(p); p += sizeof(uint64_t);
-            v2 += v1 *= PRIME;
-            v2 = _rotl(v2, 31) + getU64(p); p += sizeof(uint64_t);
-            v3 += v2 *= PRIME;
-            v3 = _rotl(v3, 33) + getU64(p); p += sizeof(uint64_t);
-            v4 += v3 *= PRIME;
-            v4 = _rotl(v4, 35) + getU64(p); p += sizeof(uint64_t);
-            v1 += v4 *= PRIME;
-        }
-    }
-#undef _rotl
-
-    size_t leftOverBytes = bEnd - p;
-
-    for (size_t i = 0; i < leftOverBytes; ++i)
-        out[i / 8] |= (static_cast<uint64_t>(p[i]) << ((i % 8) * 8));
+        std::array<uint64_t,4> m_lanes = {};
+        // big enough for a whole big block, the tail is never longer than a small one
+        std::array<uint8_t,BigBlockSize> m_buffer = {};
+        size_t m_length;
+        size_t m_bigLoopEnd = 0ull;
+        size_t m_smallLoopEnd = 0ull;
+        size_t m_processed = 0ull;
+        size_t m_buffered = 0ull;
+};
 
-    out[0] += v1;
-    out[1] += v2;
-    out[2] += v3;
-    out[3] += v4;
-
-    return { out[0],out[1],out[2],out[3] };
+constexpr std::array<uint64_t, 4> XXHash_256(const uint8_t* input, const size_t len)
+{
+    return XXHash256(len).update(input,len).finalize();
 }
 
 /*
@@ -0,0 +1,124 @@
+#ifndef _NBL_SYSTEM_C_BUFFERED_FILE_WRITER_H_INCLUDED_
+#define _NBL_SYSTEM_C_BUFFERED_FILE_WRITER_H_INCLUDED_
+
+
+#include "nbl/system/IFile.h"
+
+
+namespace nbl::system
+{
+
+//! Sequential output adaptor over an `IFile` which batches many small writes into a few large ones.
+// Keeps two staging buffers, while one is being written out by the I/O worker the other one is being filled,
+// so the formatting overlaps the disk write. Not thread-safe, meant to live on the stack of a single writer.
+class CBufferedFileWriter final
+{
+	public:
+		constexpr static inline size_t DefaultBufferSize = 0x1ull<<20u;
+
+		// `bufferSize` is per staging buffer, the writer allocates two
+		inline explicit CBufferedFileWriter(IFile* _file, const size_t _fileOffset=0ull, const size_t _bufferSize=DefaultBufferSize) :
+			m_file(_file), m_staging(core::max<size_t>(_bufferSize,1ull)*2ull), m_bufferSize(core::max<size_t>(_bufferSize,1ull)), m_fileOffset(_fileOffset) {}
+		inline ~CBufferedFileWriter()
+		{
+			flush();
+		}
+
+		// the in-flight futures point into our staging memory
+		CBufferedFileWriter(const CBufferedFileWriter&) = delete;
+		CBufferedFileWriter(CBufferedFileWriter&&) = delete;
+		CBufferedFileWriter& operator=(const CBufferedFileWriter&) = delete;
+		CBufferedFileWriter& operator=(CBufferedFileWriter&&) = delete;
+
+		//
+		inline void write(const void* data, size_t size)
+		{
+			const auto* src = reinterpret_cast<const uint8_t*>(data);
+			while (size)
+			{
+				const size_t chunk = core::min(size,m_bufferSize-m_staged);
+				memcpy(getStagingBuffer()+m_staged,src,chunk);
+				m_staged += chunk;
+				src += chunk;
+				size -= chunk;
+				if (m_staged==m_bufferSize)
+					submit();
+			}
+		}
+		template<typename T> requires std::is_trivially_copyable_v<T>
+		inline void write(const T& value)
+		{
+			write(&value,sizeof(T));
+		}
+		inline void write(const std::string_view str)
+		{
+			write(str.data(),str.size());
+		}
+
+		//! Hands the staged bytes over to the file and waits for all outstanding writes, returns false if any write so far came up short.
+		inline bool flush()
+		{
+			submit();
+			retire(0u);
+			retire(1u);
+			return !m_failed;
+		}
+
+		//! Offset in the file at which the next written byte will land
+		inline size_t getOffset() const {return m_fileOffset+m_staged;}
+
+		//
+		inline IFile* getFile() const {return m_file;}
+
+	private:
+		inline uint8_t* getStagingBuffer() {return m_staging.data()+m_current*m_bufferSize;}
+
+		inline void submit()
+		{
+			if (!m_staged)
+				return;
+			auto& inflight = m_inflight[m_current];
+			inflight.size = m_staged;
+			m_file->write(inflight.future,getStagingBuffer(),m_fileOffset,m_staged);
+			m_fileOffset += m_staged;
+			m_staged = 0ull;
+			// can only start filling the other buffer once its previous write has landed
+			m_current ^= 0x1u;
+			retire(m_current);
+		}
+		inline void retire(const uint8_t ix)
+		{
+			auto& inflight = m_inflight[ix];
+			if (!inflight.size)
+				return;
+			// release the result so the future can be reused for the next submission
+			if (auto lock=inflight.future.acquire())
+			{
+				if (*lock!=inflight.size)
+					m_failed = true;
+				lock.discard();
+			}
+			else
+				m_failed = true;
+			inflight.size = 0ull;
+		}
+
+		struct SInFlightWrite
+		{
+			ISystem::future_t<size_t> future;
+			size_t size = 0ull;
+		};
+
+		IFile* const m_file;
+		core::vector<uint8_t> m_staging;
+		const size_t m_bufferSize;
+		SInFlightWrite m_inflight[2];
+		size_t m_fileOffset;
+		size_t m_staged = 0ull;
+		uint8_t m_current = 0u;
+		bool m_failed = false;
+};
+
+}
+
+#endif
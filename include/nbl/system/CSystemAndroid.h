@@ -18,7 +18,7 @@ namespace nbl::system
 class NBL_API2 CSystemAndroid final : public ISystemPOSIX
 {
 	public:
-		CSystemAndroid(ANativeActivity* activity, JNIEnv* jni, const path& APKResourcesPath);
+		CSystemAndroid(ANativeActivity* activity, JNIEnv* jni, const path& APKResourcesPath, const uint32_t ioWorkerCount=1u);
 
 		//
 		SystemInfo getSystemInfo() const override;
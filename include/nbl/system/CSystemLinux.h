@@ -12,7 +12,7 @@ namespace nbl::system
 class CSystemLinux final : public ISystemPOSIX
 {
 	public:
-		inline CSystemLinux() : ISystemPOSIX() {}
+		inline CSystemLinux(const uint32_t ioWorkerCount=1u) : ISystemPOSIX(ioWorkerCount) {}
 
 		NBL_API2 SystemInfo getSystemInfo() const override;
 };
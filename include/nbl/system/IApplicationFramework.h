@@ -68,11 +68,11 @@ class IApplicationFramework : public core::IReferenceCounted
            return app->onAppTerminated() ? 0:(-2);
         }
 
-        static nbl::core::smart_refctd_ptr<ISystem> createSystem()
+        static nbl::core::smart_refctd_ptr<ISystem> createSystem(const uint32_t ioWorkerCount=1u)
         {
             GlobalsInit();
             #ifdef _NBL_PLATFORM_WINDOWS_
-                return nbl::core::make_smart_refctd_ptr<CSystemWin32>();
+                return nbl::core::make_smart_refctd_ptr<CSystemWin32>(ioWorkerCount);
             #elif defined(_NBL_PLATFORM_ANDROID_)
                 return nullptr;
             #endif
@@ -487,6 +487,43 @@ class IAsyncQueueDispatcher : public IThreadHandler<CRTP,InternalStateType>, pro
             }
         }
 
+        //! Number of requests submitted but not yet retired by the worker, only a hint as it can change right after returning
+        inline uint64_t getPendingRequestCount() const
+        {
+            const counter_t end = cb_end.load();
+            const counter_t begin = cb_begin.load();
+            return end>begin ? (end-begin):0ull;
+        }
+
+        //! Blocks until the worker has retired every request submitted before the call
+        inline void waitForIdle() const
+        {
+            const counter_t end = cb_end.load();
+            for (counter_t old_begin; (old_begin=cb_begin.load())<end; )
+                cb_begin.wait(old_begin);
+        }
+
+        //! Picks the dispatcher out of a non-empty range of pointers with the fewest pending requests, the scan starts at a round-robin offset so equally busy ones take turns
+        template<typename DispatcherPtrRange>
+        static inline CRTP* pickLeastBusy(const DispatcherPtrRange& dispatchers, std::atomic_uint32_t& roundRobin)
+        {
+            const uint32_t count = static_cast<uint32_t>(std::size(dispatchers));
+            const uint32_t first = roundRobin.fetch_add(1u,std::memory_order_relaxed)%count;
+            uint32_t chosen = first;
+            uint64_t minPending = dispatchers[first]->getPendingRequestCount();
+            for (uint32_t i=1u; i<count && minPending; i++)
+            {
+                const uint32_t ix = (first+i)%count;
+                const uint64_t pending = dispatchers[ix]->getPendingRequestCount();
+                if (pending<minPending)
+                {
+                    minPending = pending;
+                    chosen = ix;
+                }
+            }
+            return &*dispatchers[chosen];
+        }
+
     protected:
         inline ~IAsyncQueueDispatcher() {}
         inline void background_work() {}
@@ -515,8 +552,8 @@ class IAsyncQueueDispatcher : public IThreadHandler<CRTP,InternalStateType>, pro
                 }
                 // wake the waiter up
                 cb_begin++;
-                // this does not need to happen under a lock, because its not a condvar
-                cb_begin.notify_one();
+                // this does not need to happen under a lock, because its not a condvar, wake everyone as both `request` and `waitForIdle` wait on it
+                cb_begin.notify_all();
             }
             lock.lock();
         }
@@ -12,29 +12,68 @@ class IFile : public IFileBase, private ISystem::IFutureManipulator
 		//
 		inline void read(ISystem::future_t<size_t>& fut, void* buffer, size_t offset, size_t sizeToRead)
 		{
-			const IFileBase* constThis = this;
-			const auto* ptr = reinterpret_cast<const std::byte*>(constThis->getMappedPointer());
-			if (ptr || sizeToRead==0ull)
 			{
-				const size_t size = getSize();
-				if (offset+sizeToRead>size)
-					sizeToRead = size-offset;
-				memcpy(buffer,ptr+offset,sizeToRead);
-				set_result(fut,sizeToRead);
+				// the pin has to be taken before looking at the mapping, a growing write could be moving it
+				SMappingPin pin(this);
+				const IFileBase* constThis = this;
+				if (const auto* ptr=reinterpret_cast<const std::byte*>(constThis->getMappedPointer()); ptr || sizeToRead==0ull)
+				{
+					const size_t size = getSize();
+					if (offset+sizeToRead>size)
+						sizeToRead = size-offset;
+					memcpy(buffer,ptr+offset,sizeToRead);
+					set_result(fut,sizeToRead);
+					return;
+				}
 			}
-			else
-				unmappedRead(fut,buffer,offset,sizeToRead);
+			unmappedRead(fut,buffer,offset,sizeToRead);
+		}
+		//! Scatter read, all `spans` get serviced by a single request and the future holds the total number of bytes read.
+		// The `spans` array (not just the destinations) needs to outlive the request, spans past the end of the file get clamped.
+		inline void readv(ISystem::future_t<size_t>& fut, const std::span<const SReadSpan> spans)
+		{
+			{
+				SMappingPin pin(this);
+				const IFileBase* constThis = this;
+				if (const auto* ptr=reinterpret_cast<const std::byte*>(constThis->getMappedPointer()); ptr || spans.empty())
+				{
+					const size_t size = getSize();
+					size_t bytesRead = 0ull;
+					for (const auto& span : spans)
+					{
+						if (span.offset>=size)
+							continue;
+						const size_t sizeToRead = core::min(span.size,size-span.offset);
+						memcpy(span.dst,ptr+span.offset,sizeToRead);
+						bytesRead += sizeToRead;
+					}
+					set_result(fut,bytesRead);
+					return;
+				}
+			}
+			unmappedReadv(fut,spans);
 		}
 		//
 		inline void write(ISystem::future_t<size_t>& fut, const void* buffer, size_t offset, size_t sizeToWrite)
 		{
-			auto* ptr = reinterpret_cast<std::byte*>(getMappedPointer());
 			setLastWriteTime();
-			if (ptr || sizeToWrite==0ull)
+			bool mapped, needsGrow;
+			{
+				SMappingPin pin(this);
+				mapped = getMappedPointer() || sizeToWrite==0ull;
+				needsGrow = offset+sizeToWrite>getSize();
+			}
+			if (mapped)
 			{
-				// TODO: growable mappings
-				if (offset+sizeToWrite>getSize())
-					sizeToWrite = getSize()-offset;
+				// growing moves the mapping so it can't happen while pinned, the size never shrinks so a failed grow (or
+				// another writer growing in between) only needs the size re-checked under the pin we copy with
+				if (needsGrow)
+					growMapping(offset+sizeToWrite);
+				SMappingPin pin(this);
+				const size_t size = getSize();
+				if (offset+sizeToWrite>size)
+					sizeToWrite = offset<size ? (size-offset):0ull;
+				auto* ptr = reinterpret_cast<std::byte*>(getMappedPointer());
 				memcpy(ptr+offset,buffer,sizeToWrite);
 				set_result(fut,sizeToWrite);
 			}
@@ -84,6 +123,13 @@ class IFile : public IFileBase, private ISystem::IFutureManipulator
 			read(fut.m_internalFuture,buffer,offset,sizeToRead);
 			fut.sizeToProcess = sizeToRead;
 		}
+		void readv(success_t& fut, const std::span<const SReadSpan> spans)
+		{
+			readv(fut.m_internalFuture,spans);
+			fut.sizeToProcess = 0ull;
+			for (const auto& span : spans)
+				fut.sizeToProcess += span.size;
+		}
 		void write(success_t& fut, const void* buffer, size_t offset, size_t sizeToWrite)
 		{
 			write(fut.m_internalFuture,buffer,offset,sizeToWrite);
@@ -94,11 +140,32 @@ class IFile : public IFileBase, private ISystem::IFutureManipulator
 		// this is an abstract interface class so this stays protected
 		using IFileBase::IFileBase;
 
+		//! Backends which can extend a writable mapping override this, `newSize` becomes the new `getSize()` on success
+		/** Must not be called while the calling thread holds a pin, and must wait for all pins to be released before moving the mapping. */
+		virtual inline bool growMapping(const size_t newSize)
+		{
+			return false;
+		}
+		//! Keep the mapping from moving until the matching `unpinMapping`, any number of threads can hold a pin at once
+		virtual inline void pinMapping() const {}
+		virtual inline void unpinMapping() const {}
+		struct SMappingPin
+		{
+			inline SMappingPin(const IFile* _file) : file(_file) {file->pinMapping();}
+			inline ~SMappingPin() {file->unpinMapping();}
+
+			const IFile* const file;
+		};
+
 		//
 		virtual void unmappedRead(ISystem::future_t<size_t>& fut, void* buffer, size_t offset, size_t sizeToRead)
 		{
 			set_result(fut,0ull);
 		}
+		virtual void unmappedReadv(ISystem::future_t<size_t>& fut, const std::span<const SReadSpan> spans)
+		{
+			set_result(fut,0ull);
+		}
 		virtual void unmappedWrite(ISystem::future_t<size_t>& fut, const void* buffer, size_t offset, size_t sizeToWrite)
 		{
 			set_result(fut,0ull);
@@ -132,6 +132,13 @@ class IFileArchive : public core::IReferenceCounted
 		//
 		inline const path& getDefaultAbsolutePath() const {return m_defaultAbsolutePath;}
 
+		//! Archives which decompress their entries can keep up to `bytes` of decompressed data around after the last `IFile` using it is dropped.
+		// Opt-in, the default of 0 means every `getFile` of an entry with no outstanding references decompresses again.
+		virtual inline void setDecompressedCacheBudget(const size_t bytes) {}
+		//! Hint that the entries will be requested soon, archives with a decompressed cache can decode them concurrently ahead of time.
+		// Does nothing unless the cache budget is non-zero, and entries get evicted in LRU order if they don't all fit.
+		virtual inline void prefetch(const std::span<const path> pathsRelativeToArchive) {}
+
 	protected:
 		inline IFileArchive(path&& _defaultAbsolutePath, system::logger_opt_smart_ptr&& logger) :
 			m_defaultAbsolutePath(std::move(_defaultAbsolutePath.make_preferred())), m_logger(std::move(logger)) {}
@@ -28,6 +28,14 @@ class IFileBase : public core::IReferenceCounted
 			ECF_COHERENT = 0b1100
 		};
 
+		//! One element of a scatter read, `size` bytes starting at `offset` in the file land in `dst`
+		struct SReadSpan
+		{
+			void* dst;
+			size_t offset;
+			size_t size;
+		};
+
 		//! Get size of file.
 		/** \return Size of the file in bytes. */
 		virtual size_t getSize() const = 0;
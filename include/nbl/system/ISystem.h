@@ -162,10 +162,19 @@ class NBL_API2 ISystem : public core::IReferenceCounted
             std::string OSFullName = "Unknown";
         };
         virtual SystemInfo getSystemInfo() const = 0;
+
+        //! Writes through the mapping of a non-coherent `ECF_MAPPABLE|ECF_WRITE` file only become visible to other processes (and guaranteed on disk) after a flush
+        inline bool flushMapping(IFile* file, size_t offset, size_t size) {return m_caller->flushMapping(file,offset,size);}
+        //! Needs to be called before reading through the mapping of a non-coherent file which is being written to by someone else
+        inline bool invalidateMapping(IFile* file, size_t offset, size_t size) {return m_caller->invalidateMapping(file,offset,size);}
+
+        //! Number of threads servicing unmapped file I/O and file creation requests, fixed at construction
+        inline uint32_t getIOWorkerCount() const {return static_cast<uint32_t>(m_dispatchers.size());}
         
 
     protected:
-        // all file operations take place serially on a dedicated thread (to make fibers possible in the future)
+        // file operations take place on a pool of dedicated threads (to make fibers possible in the future),
+        // with a single worker they happen serially so backends need to be thread-safe only when `ioWorkerCount>1`
         class ICaller : public core::IReferenceCounted
         {
             public:
@@ -181,14 +190,16 @@ class NBL_API2 ISystem : public core::IReferenceCounted
                 virtual ~ICaller() = default;
 
                 // TODO: maybe change the file type to `ISystemFile` ?
-                virtual bool invalidateMapping_impl(IFile* file, size_t offset, size_t size) { assert(false); return false; } // TODO
-                virtual bool flushMapping_impl(IFile* file, size_t offset, size_t size) { assert(false); return false; } // TODO
+                // backends which can't synchronize non-coherent mappings just report failure
+                virtual bool invalidateMapping_impl(IFile* file, size_t offset, size_t size) { return false; }
+                virtual bool flushMapping_impl(IFile* file, size_t offset, size_t size) { return false; }
 
                 ISystem* m_system;
         };
 
-        //
-        explicit ISystem(core::smart_refctd_ptr<ICaller>&& caller);
+        // `ioWorkerCount` is the number of threads servicing I/O requests, backends must implement positional reads and writes
+        // (which don't touch a shared file offset) so that concurrent requests on the same file are safe
+        explicit ISystem(core::smart_refctd_ptr<ICaller>&& caller, const uint32_t ioWorkerCount=1u);
         virtual ~ISystem() {}
 
         // given an `absolutePath` find the archive it belongs to
@@ -234,6 +245,16 @@ class NBL_API2 ISystem : public core::IReferenceCounted
             size_t offset;
             size_t size;
         };
+        struct SRequestParams_READV
+        {
+            using retval_t = size_t;
+            void operator()(core::StorageTrivializer<retval_t>* retval, ICaller* _caller);
+
+            ISystemFile* file;
+            // must stay alive until the request completes, just like the destination buffers
+            const IFileBase::SReadSpan* spans;
+            size_t count;
+        };
         struct SRequestParams_WRITE
         {
             using retval_t = size_t;
@@ -250,6 +271,7 @@ class NBL_API2 ISystem : public core::IReferenceCounted
                 SRequestParams_NOOP,
                 SRequestParams_CREATE_FILE,
                 SRequestParams_READ,
+                SRequestParams_READV,
                 SRequestParams_WRITE
             > params = SRequestParams_NOOP();
         };
@@ -273,7 +295,18 @@ class NBL_API2 ISystem : public core::IReferenceCounted
         // friendship needed to be able to know about the request types
         friend class ISystemFile;
 
-        CAsyncQueue m_dispatcher;
+        // picks the least busy worker, starting the search at a round-robin offset so ties don't all land on the first queue
+        template<typename T, typename Params>
+        inline void dispatchRequest(future_t<T>* future, Params&& params)
+        {
+            CAsyncQueue::pickLeastBusy(m_dispatchers,m_nextDispatcher)->request(future,std::forward<Params>(params));
+        }
+
+        // mapping flushes and invalidations are synchronous so they bypass the queues
+        core::smart_refctd_ptr<ICaller> m_caller;
+        // each dispatcher owns a thread, they're not movable so we keep them by pointer
+        core::vector<std::unique_ptr<CAsyncQueue>> m_dispatchers;
+        std::atomic_uint32_t m_nextDispatcher = 0u;
 };
 
 }
@@ -31,7 +31,15 @@ class ISystemFile : public IFile
 			params.file = this;
 			params.offset = offset;
 			params.size = sizeToRead;
-			m_system->m_dispatcher.request(&fut,params);
+			m_system->dispatchRequest(&fut,params);
+		}
+		inline void unmappedReadv(ISystem::future_t<size_t>& fut, const std::span<const SReadSpan> spans) override final
+		{
+			ISystem::SRequestParams_READV params;
+			params.file = this;
+			params.spans = spans.data();
+			params.count = spans.size();
+			m_system->dispatchRequest(&fut,params);
 		}
 		inline void unmappedWrite(ISystem::future_t<size_t>& fut, const void* buffer, size_t offset, size_t sizeToWrite) override final
 		{
@@ -40,12 +48,21 @@ class ISystemFile : public IFile
 			params.file = this;
 			params.offset = offset;
 			params.size = sizeToWrite;
-			m_system->m_dispatcher.request(&fut,params);
+			m_system->dispatchRequest(&fut,params);
 		}
 
 		//
 		friend struct ISystem::SRequestParams_READ;
 		virtual size_t asyncRead(void* buffer, size_t offset, size_t sizeToRead) = 0;
+		friend struct ISystem::SRequestParams_READV;
+		// backends with a native scatter read should override, this fallback still saves on dispatcher round-trips
+		virtual inline size_t asyncReadv(const SReadSpan* spans, size_t count)
+		{
+			size_t bytesRead = 0ull;
+			for (size_t i=0ull; i<count; i++)
+				bytesRead += asyncRead(spans[i].dst,spans[i].offset,spans[i].size);
+			return bytesRead;
+		}
 		friend struct ISystem::SRequestParams_WRITE;
 		virtual size_t asyncWrite(const void* buffer, size_t offset, size_t sizeToWrite) = 0;
 
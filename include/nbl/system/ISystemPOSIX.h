@@ -19,9 +19,13 @@ class ISystemPOSIX : public ISystem
                 inline CCaller(ISystemPOSIX* _system) : ICaller(_system) {}
 
                 NBL_API2 core::smart_refctd_ptr<ISystemFile> createFile(const std::filesystem::path& filename, const core::bitflag<IFile::E_CREATE_FLAGS> flags) override;
+
+            protected:
+                NBL_API2 bool invalidateMapping_impl(IFile* file, size_t offset, size_t size) override;
+                NBL_API2 bool flushMapping_impl(IFile* file, size_t offset, size_t size) override;
         };
 
-        inline ISystemPOSIX() : ISystem(core::make_smart_refctd_ptr<CCaller>(this)) {}
+        inline ISystemPOSIX(const uint32_t ioWorkerCount=1u) : ISystem(core::make_smart_refctd_ptr<CCaller>(this),ioWorkerCount) {}
 };
 #endif
 
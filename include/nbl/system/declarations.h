@@ -15,6 +15,7 @@
 
 // files
 #include "nbl/system/IFile.h"
+#include "nbl/system/CBufferedFileWriter.h"
 
 // archives
 #include "nbl/system/CMountDirectoryArchive.h"
@@ -4,8 +4,64 @@
 
 #include "nbl/asset/IAsset.h"
 
+#include "nbl/core/execution.h"
+
+using namespace nbl;
 using namespace nbl::asset;
 
 IAsset::~IAsset()
 {
-}
\ No newline at end of file
+}
+
+std::optional<IAsset::content_hash_t> IAsset::computeContentHash(content_hash_cache_t* cache) const
+{
+	content_hash_cache_t localCache;
+	if (!cache)
+		cache = &localCache;
+	if (auto found=cache->find(this); found!=cache->end())
+		return found->second;
+
+	std::optional<content_hash_t> retval;
+	if (!isADummyObjectForCache())
+	{
+		SContentHashInput input = {.input={},.cache=*cache};
+		input.append(getAssetType());
+		if (computeContentHash_impl(input))
+			retval = core::XXHash_256(input.input.data(),input.input.size());
+	}
+	// the dependencies hashed in the meantime could have rehashed the map, so can't reuse an iterator from before
+	cache->emplace(this,retval);
+	return retval;
+}
+
+bool IAsset::SContentHashInput::appendDependency(const IAsset* dependency)
+{
+	if (!dependency)
+	{
+		append(ET_TERMINATING_ZERO);
+		return true;
+	}
+	const auto hash = dependency->computeContentHash(&cache);
+	if (!hash)
+		return false;
+	append(hash->data(),sizeof(content_hash_t));
+	return true;
+}
+
+IAsset::content_hash_t IAsset::hashContentBytes(const void* data, const size_t size)
+{
+	// part of the hash definition, changing it changes every hash of a buffer bigger than this
+	constexpr size_t ChunkSize = 0x1ull<<20u;
+	const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+	if (size<=ChunkSize)
+		return core::XXHash_256(bytes,size);
+
+	// Merkle again, hash the chunks independently and then the concatenation of their hashes
+	core::vector<content_hash_t> chunkHashes((size-1ull)/ChunkSize+1ull);
+	std::for_each(core::execution::par_unseq,chunkHashes.begin(),chunkHashes.end(),[&](content_hash_t& chunkHash)->void
+	{
+		const size_t offset = std::distance(chunkHashes.data(),&chunkHash)*ChunkSize;
+		chunkHash = core::XXHash_256(bytes+offset,core::min(size-offset,ChunkSize));
+	});
+	return core::XXHash_256(reinterpret_cast<const uint8_t*>(chunkHashes.data()),chunkHashes.size()*sizeof(content_hash_t));
+}
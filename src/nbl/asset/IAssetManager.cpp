@@ -121,6 +121,156 @@ std::function<void(SAssetBundle&)> nbl::asset::makeAssetDisposeFunc(const IAsset
 	};
 }
 
+void IAssetManager::getAssetAsync(future_t<SAssetBundle>& future, const std::string& _filename, const IAssetLoader::SAssetLoadParams& _params, IAssetLoader::IAssetLoaderOverride* _override)
+{
+    std::call_once(m_asyncLoadQueuesInit,[this]()->void
+    {
+        m_asyncLoadQueues.reserve(m_asyncLoaderThreadCount);
+        for (uint32_t i=0u; i<m_asyncLoaderThreadCount; i++)
+            m_asyncLoadQueues.push_back(std::make_unique<CAsyncLoadQueue>(this));
+    });
+    if (!_override)
+        _override = &m_defaultLoaderOverride;
+
+    // attach to a compatible load of the same file that's already in flight, duplicated top level assets can't be shared
+    std::shared_ptr<SInFlightLoad> inFlight;
+    CAsyncLoadQueue* queue = nullptr;
+    if ((_params.cacheFlags&IAssetLoader::ECF_DUPLICATE_TOP_LEVEL)!=IAssetLoader::ECF_DUPLICATE_TOP_LEVEL)
+    {
+        std::string key = (_params.workingDirectory/_filename).lexically_normal().generic_string();
+        std::unique_lock lock(m_inFlightLoadsMutex);
+        auto found = m_inFlightLoads.find(key);
+        if (found==m_inFlightLoads.end())
+        {
+            // same queue selection as the ISystem I/O workers
+            queue = CAsyncLoadQueue::pickLeastBusy(m_asyncLoadQueues,m_nextAsyncLoadQueue);
+            inFlight = std::make_shared<SInFlightLoad>(std::string(key),_params,_override,queue);
+            m_inFlightLoads.insert({std::move(key),inFlight});
+        }
+        else if (found->second->compatible(_params,_override))
+        {
+            inFlight = found->second;
+            inFlight->pending++;
+            queue = inFlight->queue;
+        }
+    }
+    if (!queue)
+        queue = CAsyncLoadQueue::pickLeastBusy(m_asyncLoadQueues,m_nextAsyncLoadQueue);
+    // enqueue outside the lock, the queue might be full and its worker needs the lock to retire requests
+    queue->request(&future,std::string(_filename),_params,_override,std::move(inFlight));
+}
+
+IAssetManager::SDeduplicationStatistics IAssetManager::deduplicate(std::span<const SAssetBundle> bundles)
+{
+	// gather everything reachable from the roots once, dependencies end up before the assets using them
+	core::unordered_set<const IAsset*> roots;
+	core::vector<IAsset*> assets;
+	{
+		core::unordered_set<const IAsset*> visited;
+		// second member tells whether the dependencies were pushed already
+		core::vector<std::pair<const IAsset*,bool>> stack;
+		for (const auto& bundle : bundles)
+		for (const auto& root : bundle.getContents())
+		if (root)
+		{
+			roots.insert(root.get());
+			stack.emplace_back(root.get(),false);
+		}
+		while (!stack.empty())
+		{
+			const auto [asset,expanded] = stack.back();
+			if (expanded || !visited.insert(asset).second)
+			{
+				stack.pop_back();
+				if (expanded)
+					assets.push_back(const_cast<IAsset*>(asset));
+				continue;
+			}
+			stack.back().second = true;
+			asset->visitDependencies([&](const IAsset* dependency)->void
+			{
+				if (!visited.contains(dependency))
+					stack.emplace_back(dependency,false);
+			});
+		}
+	}
+
+	// roots get to be the canonical copies first, they stay alive no matter what
+	struct content_hash_hasher
+	{
+		inline size_t operator()(const IAsset::content_hash_t& hash) const {return hash[0];}
+	};
+	core::unordered_map<IAsset::content_hash_t,IAsset*,content_hash_hasher> canonical;
+	core::unordered_map<const IAsset*,IAsset*> replacements;
+	IAsset::content_hash_cache_t hashCache;
+	for (const bool rootPass : {true,false})
+	for (auto* asset : assets)
+	{
+		if (roots.contains(asset)!=rootPass)
+			continue;
+		const auto hash = asset->computeContentHash(&hashCache);
+		if (!hash)
+			continue;
+		const auto [found,inserted] = canonical.emplace(*hash,asset);
+		if (!inserted)
+			replacements.emplace(asset,found->second);
+	}
+	if (replacements.empty())
+		return {};
+
+	// immutable assets keep referencing their duplicates
+	core::unordered_set<const IAsset*> stillReferenced;
+	for (auto* asset : assets)
+	{
+		const bool replaced = asset->replaceDependencies([&replacements](const IAsset* dependency)->IAsset*
+		{
+			auto found = replacements.find(dependency);
+			return found!=replacements.end() ? found->second:nullptr;
+		});
+		if (!replaced)
+		asset->visitDependencies([&](const IAsset* dependency)->void
+		{
+			if (replacements.contains(dependency))
+				stillReferenced.insert(dependency);
+		});
+	}
+
+	SDeduplicationStatistics retval;
+	for (const auto& [duplicate,original] : replacements)
+	if (!roots.contains(duplicate) && !stillReferenced.contains(duplicate))
+	{
+		retval.assetsRemoved++;
+		retval.bytesSaved += duplicate->conservativeSizeEstimate();
+	}
+	return retval;
+}
+
+void IAssetManager::CAsyncLoadQueue::process_request(base_t::future_base_t* _future_base, SAsyncLoadRequest& req)
+{
+    base_t::future_storage_cast<SAssetBundle>(_future_base)->construct(m_manager->loadCoalesced(req));
+}
+
+SAssetBundle IAssetManager::loadCoalesced(SAsyncLoadRequest& req)
+{
+    if (!req.inFlight)
+        return getAssetInHierarchy(req.filename,*req.params,0u,req.override);
+
+    // all requests attached to the same load run on this thread in order, so whichever comes first does the loading
+    auto inFlight = std::move(req.inFlight);
+    if (!inFlight->done)
+    {
+        inFlight->result = getAssetInHierarchy(req.filename,*req.params,0u,req.override);
+        inFlight->done = true;
+    }
+    SAssetBundle bundle = inFlight->result;
+    {
+        std::unique_lock lock(m_inFlightLoadsMutex);
+        if (--inFlight->pending==0u)
+            m_inFlightLoads.erase(inFlight->key);
+    }
+    return bundle;
+}
+
 void IAssetManager::initializeMeshTools()
 {
 	m_meshManipulator = core::make_smart_refctd_ptr<CMeshManipulator>();
@@ -174,7 +324,7 @@ void IAssetManager::addLoadersAndWriters()
 #ifdef _NBL_COMPILE_WITH_TGA_LOADER_
 	addAssetLoader(core::make_smart_refctd_ptr<asset::CImageLoaderTGA>());
 #endif
-    addAssetLoader(core::make_smart_refctd_ptr<asset::CBufferLoaderBIN>());
+    addAssetLoader(core::make_smart_refctd_ptr<asset::CBufferLoaderBIN>(core::smart_refctd_ptr<system::ISystem>(m_system)));
 	addAssetLoader(core::make_smart_refctd_ptr<asset::CGLSLLoader>());
 	addAssetLoader(core::make_smart_refctd_ptr<asset::CHLSLLoader>());
 	addAssetLoader(core::make_smart_refctd_ptr<asset::CSPVLoader>());
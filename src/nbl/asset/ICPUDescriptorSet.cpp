@@ -253,4 +253,47 @@ bool ICPUDescriptorSet::isAnyDependencyDummy_impl(uint32_t _levelsBelow) const
 	return false;
 }
 
+void ICPUDescriptorSet::visitDependencies_impl(const dependency_visitor_t& visitor)
+{
+	visitDependency(m_layout,visitor);
+
+	// the descriptors are type erased, need to go through the concrete asset types to keep the replacement typed,
+	// and only write back actual replacements because the read-only `visitDependencies` ends up here too
+	for (uint32_t t = 0u; t < static_cast<uint32_t>(IDescriptor::E_TYPE::ET_COUNT); ++t)
+	{
+		if (!m_descriptorInfos[t])
+			continue;
+
+		const auto category = getCategoryFromType(static_cast<IDescriptor::E_TYPE>(t));
+		for (auto& descriptorInfo : *m_descriptorInfos[t])
+		{
+			if (!descriptorInfo.desc)
+				continue;
+
+			switch (category)
+			{
+			case IDescriptor::EC_BUFFER:
+				if (auto* replacement=visitor(static_cast<ICPUBuffer*>(descriptorInfo.desc.get())))
+					descriptorInfo.desc = core::smart_refctd_ptr<ICPUBuffer>(static_cast<ICPUBuffer*>(replacement));
+				break;
+
+			case IDescriptor::EC_IMAGE:
+			{
+				if (auto* replacement=visitor(static_cast<ICPUImageView*>(descriptorInfo.desc.get())))
+					descriptorInfo.desc = core::smart_refctd_ptr<ICPUImageView>(static_cast<ICPUImageView*>(replacement));
+				visitDependency(descriptorInfo.info.image.sampler,visitor);
+			} break;
+
+			case IDescriptor::EC_BUFFER_VIEW:
+				if (auto* replacement=visitor(static_cast<ICPUBufferView*>(descriptorInfo.desc.get())))
+					descriptorInfo.desc = core::smart_refctd_ptr<ICPUBufferView>(static_cast<ICPUBufferView*>(replacement));
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+}
+
 }
\ No newline at end of file
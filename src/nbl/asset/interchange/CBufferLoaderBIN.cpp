@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in nabla.h
 #include "CBufferLoaderBIN.h"
 
+#include "nbl/asset/CFileMappedCPUBuffer.h"
+
 using namespace nbl;
 using namespace nbl::asset;
 
@@ -11,6 +13,21 @@ asset::SAssetBundle CBufferLoaderBIN::loadAsset(system::IFile* _file, const asse
 	if (!_file)
 		return {};
 
+	// zero-copy path, the buffer references the mapping and pages get faulted in lazily
+	{
+		core::smart_refctd_ptr<system::IFile> mappedFile(_file);
+		const system::IFile* constFile = _file;
+		if (!constFile->getMappedPointer() && m_system && _file->getSize())
+		{
+			system::ISystem::future_t<core::smart_refctd_ptr<system::IFile>> future;
+			m_system->createFile(future,_file->getFileName(),core::bitflag(system::IFile::ECF_READ)|system::IFile::ECF_MAPPABLE);
+			if (auto lock=future.acquire())
+				lock.move_into(mappedFile);
+		}
+		if (auto buffer=CFileMappedCPUBuffer::create(std::move(mappedFile)))
+			return SAssetBundle(nullptr,{std::move(buffer)});
+	}
+
 	SContext ctx(_file->getSize());
 	ctx.file = _file;
 
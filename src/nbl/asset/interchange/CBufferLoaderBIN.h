@@ -20,7 +20,7 @@ class CBufferLoaderBIN final : public asset::IAssetLoader
 		~CBufferLoaderBIN() = default;
 
 	public:
-		CBufferLoaderBIN() {}
+		CBufferLoaderBIN(core::smart_refctd_ptr<system::ISystem>&& _system=nullptr) : m_system(std::move(_system)) {}
 		bool isALoadableFileFormat(system::IFile* _file, const system::logger_opt_ptr logger) const override;
 
 		const char** getAssociatedFileExtensions() const override
@@ -40,6 +40,9 @@ class CBufferLoaderBIN final : public asset::IAssetLoader
 			system::IFile* file;
 			core::smart_refctd_ptr<ICPUBuffer> sourceCodeBuffer;
 		};
+
+		// used to reopen files that weren't opened with `ECF_MAPPABLE`
+		core::smart_refctd_ptr<system::ISystem> m_system;
 };
 
 }
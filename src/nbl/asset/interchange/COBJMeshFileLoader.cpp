@@ -13,12 +13,16 @@
 #include "nbl/system/ISystem.h"
 #include "nbl/system/IFile.h"
 
+#include "nbl/core/execution.h"
+
 #include "nbl/asset/metadata/COBJMetadata.h"
 #include "nbl/asset/utils/CQuantNormalCache.h"
 
 #include "COBJMeshFileLoader.h"
 
+#include <charconv>
 #include <filesystem>
+#include <thread>
 
 namespace nbl
 {
@@ -47,6 +51,232 @@ COBJMeshFileLoader::~COBJMeshFileLoader()
 {
 }
 
+namespace
+{
+struct vec3
+{
+	float data[3];
+};
+struct vec2
+{
+	float data[2];
+};
+
+inline bool isInlineSpace(const char c)
+{
+	return c==' ' || c=='\t' || c=='\r' || c=='\v' || c=='\f';
+}
+inline const char* skipInlineSpace(const char* ptr, const char* const end)
+{
+	while (ptr!=end && isInlineSpace(*ptr))
+		++ptr;
+	return ptr;
+}
+inline const char* findLineEnd(const char* ptr, const char* const end)
+{
+	const auto* found = reinterpret_cast<const char*>(memchr(ptr,'\n',end-ptr));
+	return found ? found:end;
+}
+// returns the next whitespace delimited word on the line, `ptr` gets moved past it
+inline std::string_view nextWord(const char*& ptr, const char* const lineEnd)
+{
+	ptr = skipInlineSpace(ptr,lineEnd);
+	const char* const wordBegin = ptr;
+	while (ptr!=lineEnd && !isInlineSpace(*ptr))
+		++ptr;
+	return std::string_view(wordBegin,ptr-wordBegin);
+}
+inline float parseFloat(const char*& ptr, const char* const lineEnd)
+{
+	float retval = 0.f;
+	const std::string_view word = nextWord(ptr,lineEnd);
+	const char* begin = word.data();
+	// `from_chars` doesn't accept an explicit plus sign
+	if (begin!=ptr && *begin=='+')
+		begin++;
+	std::from_chars(begin,ptr,retval);
+	return retval;
+}
+
+//! Result of tokenizing a line aligned part of the file independently of all the others.
+// Statements are kept in file order so that the stateful part of OBJ (materials, groups, smoothing) can be replayed serially.
+struct SParsedChunk
+{
+	// raw OBJ indices, 0 means the index was not present
+	struct SCorner
+	{
+		int32_t pos = 0;
+		int32_t uv = 0;
+		int32_t normal = 0;
+	};
+	struct SStatement
+	{
+		enum class E_TYPE : uint8_t
+		{
+			VERTEX_DATA,
+			FACE,
+			MTLLIB,
+			USEMTL,
+			GROUP,
+			SMOOTHING
+		};
+
+		E_TYPE type;
+		// attribute counts within the chunk so far, needed to resolve relative indices
+		uint32_t positionCount = 0u;
+		uint32_t uvCount = 0u;
+		uint32_t normalCount = 0u;
+		// range in `corners` for faces
+		uint32_t firstCorner = 0u;
+		uint32_t cornerCount = 0u;
+		std::string_view argument = {};
+	};
+
+	inline void parse(const bool rightHanded)
+	{
+		// positions and normals get their X flipped unless loading as right handed
+		const float xSign = rightHanded ? 1.f:-1.f;
+		for (const char* lineBegin=begin; lineBegin<end;)
+		{
+			const char* const lineEnd = findLineEnd(lineBegin,end);
+			const char* ptr = skipInlineSpace(lineBegin,lineEnd);
+			if (ptr!=lineEnd)
+			switch (*ptr)
+			{
+				case 'v':
+				{
+					// consecutive attribute lines only need one marker
+					if (statements.empty() || statements.back().type!=SStatement::E_TYPE::VERTEX_DATA)
+						statements.push_back({SStatement::E_TYPE::VERTEX_DATA});
+					const char kind = ++ptr!=lineEnd ? *ptr:'\0';
+					if (kind=='n' || kind=='t')
+						++ptr;
+					switch (isInlineSpace(kind) ? ' ':kind)
+					{
+						case ' ':
+						{
+							vec3& vec = positions.emplace_back();
+							for (auto i=0; i<3; i++)
+								vec.data[i] = parseFloat(ptr,lineEnd);
+							vec.data[0] *= xSign;
+							break;
+						}
+						case 'n':
+						{
+							vec3& vec = normals.emplace_back();
+							for (auto i=0; i<3; i++)
+								vec.data[i] = parseFloat(ptr,lineEnd);
+							vec.data[0] *= xSign;
+							break;
+						}
+						case 't':
+						{
+							vec2& vec = uvs.emplace_back();
+							vec.data[0] = parseFloat(ptr,lineEnd);
+							vec.data[1] = 1.f-parseFloat(ptr,lineEnd); // change handedness
+							break;
+						}
+						default:
+							break;
+					}
+					break;
+				}
+				case 'f':
+				{
+					nextWord(ptr,lineEnd);
+					SStatement& face = statements.emplace_back(SStatement{SStatement::E_TYPE::FACE,uint32_t(positions.size()),uint32_t(uvs.size()),uint32_t(normals.size()),uint32_t(corners.size())});
+					for (auto word=nextWord(ptr,lineEnd); !word.empty(); word=nextWord(ptr,lineEnd))
+					{
+						// v, v/vt, v//vn or v/vt/vn
+						SCorner& corner = corners.emplace_back();
+						int32_t* const out[3] = {&corner.pos,&corner.uv,&corner.normal};
+						const char* it = word.data();
+						const char* const wordEnd = it+word.size();
+						for (auto i=0; i<3 && it!=wordEnd; i++)
+						{
+							it = std::from_chars(it,wordEnd,*out[i]).ptr;
+							while (it!=wordEnd && *it!='/')
+								++it;
+							if (it!=wordEnd)
+								++it;
+						}
+						face.cornerCount++;
+					}
+					break;
+				}
+				case 'm': // mtllib
+					pushNamedStatement(SStatement::E_TYPE::MTLLIB,ptr,lineEnd);
+					break;
+				case 'u': // usemtl
+					pushNamedStatement(SStatement::E_TYPE::USEMTL,ptr,lineEnd);
+					break;
+				case 'g': // group name
+					pushNamedStatement(SStatement::E_TYPE::GROUP,ptr,lineEnd);
+					break;
+				case 's': // smoothing group
+					pushNamedStatement(SStatement::E_TYPE::SMOOTHING,ptr,lineEnd);
+					break;
+				case '#': // comment
+				default:
+					break;
+			}
+			lineBegin = lineEnd+1;
+		}
+	}
+
+	// the argument of named statements is the first word after the keyword
+	inline void pushNamedStatement(const SStatement::E_TYPE type, const char* ptr, const char* const lineEnd)
+	{
+		nextWord(ptr,lineEnd);
+		SStatement& statement = statements.emplace_back(SStatement{type});
+		statement.argument = nextWord(ptr,lineEnd);
+	}
+
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	core::vector<vec3> positions;
+	core::vector<vec3> normals;
+	core::vector<vec2> uvs;
+	core::vector<SCorner> corners;
+	core::vector<SStatement> statements;
+	// offsets of this chunk's attributes in the concatenated arrays
+	size_t positionBase = 0ull;
+	size_t uvBase = 0ull;
+	size_t normalBase = 0ull;
+};
+
+// vertices are only merged within a smoothing group, compared bitwise because missing UVs are NaN
+struct SVertexKey
+{
+	SObjVertex vertex;
+	uint32_t smoothingGroup;
+
+	struct hash
+	{
+		inline size_t operator()(const SVertexKey& key) const
+		{
+			uint32_t words[sizeof(SVertexKey)/sizeof(uint32_t)];
+			memcpy(words,&key,sizeof(words));
+			uint64_t retval = 0xcbf29ce484222325ull;
+			for (const auto word : words)
+			{
+				retval = (retval^word)*0x9E3779B97F4A7C15ull;
+				retval ^= retval>>32u;
+			}
+			return retval;
+		}
+	};
+	struct equal_to
+	{
+		inline bool operator()(const SVertexKey& lhs, const SVertexKey& rhs) const
+		{
+			return memcmp(&lhs,&rhs,sizeof(SVertexKey))==0;
+		}
+	};
+};
+static_assert(sizeof(SVertexKey)==sizeof(SObjVertex)+sizeof(uint32_t));
+}
+
 asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const asset::IAssetLoader::SAssetLoadParams& _params, asset::IAssetLoader::IAssetLoaderOverride* _override, uint32_t _hierarchyLevel)
 {
     SContext ctx(
@@ -70,9 +300,6 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 	if (!filesize)
         return {};
 
-	const uint32_t WORD_BUFFER_LENGTH = 512u;
-    char tmpbuf[WORD_BUFFER_LENGTH]{};
-
 	uint32_t smoothingGroup=0;
 
 	const std::filesystem::path fullName = _file->getFileName();
@@ -100,21 +327,6 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 	};
     core::unordered_multiset<pipeline_meta_pair_t,hash_t,key_equal_t> pipelines;
 
-	// TODO: map the file whenever possible
-    std::string fileContents;
-    fileContents.resize(filesize);
-	char* const buf = fileContents.data();
-
-	system::IFile::success_t success;
-	_file->read(success, buf, 0, filesize);
-	if (!success)
-		return {};
-
-	const char* const bufEnd = buf+filesize;
-	// Process obj information
-	const char* bufPtr = buf;
-	std::string grpName, mtlName;
-
 	auto performActionBasedOnOrientationSystem = [&](auto performOnRightHanded, auto performOnLeftHanded)
 	{
 		if (_params.loaderFlags & E_LOADER_PARAMETER_FLAGS::ELPF_RIGHT_HANDED_MESHES)
@@ -123,21 +335,107 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 			performOnLeftHanded();
 	};
 
+	// map the file whenever possible, fall back to reading it into memory
+	core::smart_refctd_ptr<system::IFile> mappedFile(_file);
+	{
+		const system::IFile* constFile = _file;
+		if (!constFile->getMappedPointer() && System)
+		{
+			system::ISystem::future_t<core::smart_refctd_ptr<system::IFile>> future;
+			System->createFile(future,_file->getFileName(),core::bitflag(system::IFile::ECF_READ)|system::IFile::ECF_MAPPABLE);
+			core::smart_refctd_ptr<system::IFile> reopened;
+			if (auto lock=future.acquire())
+				lock.move_into(reopened);
+			if (reopened && reopened->getSize()==static_cast<size_t>(filesize))
+				mappedFile = std::move(reopened);
+		}
+	}
+	std::string fileContents;
+	const char* buf = reinterpret_cast<const char*>(static_cast<const system::IFile*>(mappedFile.get())->getMappedPointer());
+	if (!buf)
+	{
+		fileContents.resize(filesize);
+		system::IFile::success_t success;
+		_file->read(success, fileContents.data(), 0, filesize);
+		if (!success)
+			return {};
+		buf = fileContents.data();
+	}
+	const char* const bufEnd = buf+filesize;
+
+	// split into line aligned chunks and tokenize them in parallel, only the stateful part (materials, groups, dedup) runs serially
+	core::vector<SParsedChunk> chunks;
+	{
+		constexpr size_t MinChunkSize = 0x1ull<<20u;
+		const size_t maxChunks = core::max(std::thread::hardware_concurrency(),1u)*4ull;
+		const size_t chunkCount = core::min<size_t>(core::max<size_t>(filesize/MinChunkSize,1ull),maxChunks);
+		chunks.resize(chunkCount);
+		const char* chunkBegin = buf;
+		for (size_t i=0ull; i<chunkCount; i++)
+		{
+			const char* chunkEnd = bufEnd;
+			if (i+1ull<chunkCount)
+			{
+				chunkEnd = core::max(buf+(filesize*(i+1ull))/chunkCount,chunkBegin);
+				chunkEnd = findLineEnd(chunkEnd,bufEnd);
+				if (chunkEnd!=bufEnd)
+					chunkEnd++;
+			}
+			chunks[i].begin = chunkBegin;
+			chunks[i].end = chunkEnd;
+			chunkBegin = chunkEnd;
+		}
+		const bool rightHanded = _params.loaderFlags&E_LOADER_PARAMETER_FLAGS::ELPF_RIGHT_HANDED_MESHES;
+		std::for_each(core::execution::par,chunks.begin(),chunks.end(),[rightHanded](SParsedChunk& chunk)->void{chunk.parse(rightHanded);});
+	}
+
+	// gather the attributes and remember where each chunk's start in the global arrays, for resolving indices
+	core::vector<vec3> vertexBuffer;
+	core::vector<vec3> normalsBuffer;
+	core::vector<vec2> textureCoordBuffer;
+	{
+		size_t positionCount = 0ull, uvCount = 0ull, normalCount = 0ull;
+		for (auto& chunk : chunks)
+		{
+			chunk.positionBase = positionCount;
+			chunk.uvBase = uvCount;
+			chunk.normalBase = normalCount;
+			positionCount += chunk.positions.size();
+			uvCount += chunk.uvs.size();
+			normalCount += chunk.normals.size();
+		}
+		vertexBuffer.reserve(positionCount);
+		textureCoordBuffer.reserve(uvCount);
+		normalsBuffer.reserve(normalCount);
+		for (auto& chunk : chunks)
+		{
+			vertexBuffer.insert(vertexBuffer.end(),chunk.positions.begin(),chunk.positions.end());
+			textureCoordBuffer.insert(textureCoordBuffer.end(),chunk.uvs.begin(),chunk.uvs.end());
+			normalsBuffer.insert(normalsBuffer.end(),chunk.normals.begin(),chunk.normals.end());
+			core::vector<vec3>().swap(chunk.positions);
+			core::vector<vec2>().swap(chunk.uvs);
+			core::vector<vec3>().swap(chunk.normals);
+		}
+	}
+	// quantize every normal once instead of once per face corner
+	using quant_normal_t = CQuantNormalCache::value_type_t<EF_A2B10G10R10_SNORM_PACK32>;
+	core::vector<quant_normal_t> quantizedNormals(normalsBuffer.size());
+	for (size_t i=0ull; i<normalsBuffer.size(); i++)
+	{
+		core::vectorSIMDf simdNormal;
+		simdNormal.set(normalsBuffer[i].data);
+		simdNormal.makeSafe3D();
+		quantizedNormals[i] = quantNormalCache->quantize<EF_A2B10G10R10_SNORM_PACK32>(simdNormal);
+	}
 
-    struct vec3 {
-        float data[3];
-    };
-    struct vec2 {
-        float data[2];
-    };
-    core::vector<vec3> vertexBuffer;
-    core::vector<vec3> normalsBuffer;
-    core::vector<vec2> textureCoordBuffer;
+	std::string grpName, mtlName;
 
     core::vector<core::smart_refctd_ptr<ICPUMeshBuffer>> submeshes;
     core::vector<core::vector<uint32_t>> indices;
     core::vector<SObjVertex> vertices;
-    core::map<SObjVertex, uint32_t> map_vtx2ix;
+    core::unordered_map<SVertexKey,uint32_t,SVertexKey::hash,SVertexKey::equal_to> map_vtx2ix;
+    map_vtx2ix.reserve(vertexBuffer.size());
+    vertices.reserve(vertexBuffer.size());
     core::vector<bool> recalcNormals;
     core::vector<bool> submeshWasLoadedFromCache;
     core::vector<std::string> submeshCacheKeys;
@@ -148,18 +446,20 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 	constexpr const char* NO_MATERIAL_MTL_NAME = "#";
 	bool noMaterial = true;
 	bool dummyMaterialCreated = false;
-	while(bufPtr != bufEnd)
+	core::vector<uint32_t> faceCorners;
+	faceCorners.reserve(32ull);
+	for (const auto& chunk : chunks)
+	for (const auto& statement : chunk.statements)
 	{
-		switch(bufPtr[0])
+		switch (statement.type)
 		{
-		case 'm':	// mtllib (material)
+		case SParsedChunk::SStatement::E_TYPE::MTLLIB:
 		{
 			if (ctx.useMaterials)
 			{
-				bufPtr = goAndCopyNextWord(tmpbuf, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-				_params.logger.log("Reading material _file %s", system::ILogger::ELL_DEBUG, tmpbuf);
+				std::string mtllib(statement.argument.substr(0ull,WORD_BUFFER_LENGTH-1u));
+				_params.logger.log("Reading material _file %s", system::ILogger::ELL_DEBUG, mtllib.c_str());
 
-                std::string mtllib = tmpbuf;
                 std::replace(mtllib.begin(), mtllib.end(), '\\', '/');
                 SAssetLoadParams loadParams(_params);
 				loadParams.workingDirectory = _file->getFileName().parent_path();
@@ -186,62 +486,31 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 		}
 			break;
 
-		case 'v':               // v, vn, vt
+		case SParsedChunk::SStatement::E_TYPE::VERTEX_DATA:
 			//reset flags
 			noMaterial = true;
 			dummyMaterialCreated = false;
-			switch(bufPtr[1])
-			{
-			case ' ':          // vertex
-				{
-					vec3 vec;
-					bufPtr = readVec3(bufPtr, vec.data, bufEnd);
-					performActionBasedOnOrientationSystem([&]() {vec.data[0] = -vec.data[0];}, [&]() {});
-					vertexBuffer.push_back(vec);
-				}
-				break;
-
-			case 'n':       // normal
-				{
-					vec3 vec;
-					bufPtr = readVec3(bufPtr, vec.data, bufEnd);
-					performActionBasedOnOrientationSystem([&]() {vec.data[0] = -vec.data[0]; }, [&]() {});
-					normalsBuffer.push_back(vec);
-				}
-				break;
-
-			case 't':       // texcoord
-				{
-					vec2 vec;
-					bufPtr = readUV(bufPtr, vec.data, bufEnd);
-					textureCoordBuffer.push_back(vec);
-				}
-				break;
-			}
 			break;
 
-		case 'g': // group name
-            bufPtr = goAndCopyNextWord(tmpbuf, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-            grpName = tmpbuf;
+		case SParsedChunk::SStatement::E_TYPE::GROUP:
+            grpName = statement.argument.substr(0ull,WORD_BUFFER_LENGTH-1u);
 			break;
-		case 's': // smoothing can be a group or off (equiv. to 0)
+		case SParsedChunk::SStatement::E_TYPE::SMOOTHING: // smoothing can be a group or off (equiv. to 0)
 			{
-				bufPtr = goAndCopyNextWord(tmpbuf, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-				_params.logger.log("Loaded smoothing group start %s",system::ILogger::ELL_DEBUG, tmpbuf);
-				if (strcmp("off", tmpbuf)==0)
+				_params.logger.log("Loaded smoothing group start %s",system::ILogger::ELL_DEBUG, std::string(statement.argument).c_str());
+				if (statement.argument=="off")
 					smoothingGroup=0u;
 				else
-                    sscanf(tmpbuf,"%u",&smoothingGroup);
+					std::from_chars(statement.argument.data(),statement.argument.data()+statement.argument.size(),smoothingGroup);
 			}
 			break;
 
-		case 'u': // usemtl
+		case SParsedChunk::SStatement::E_TYPE::USEMTL:
 			// get name of material
 			{
 				noMaterial = false;
-				bufPtr = goAndCopyNextWord(tmpbuf, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-				_params.logger.log("Loaded material start %s", system::ILogger::ELL_DEBUG, tmpbuf);
-				mtlName=tmpbuf;
+				mtlName = statement.argument.substr(0ull,WORD_BUFFER_LENGTH-1u);
+				_params.logger.log("Loaded material start %s", system::ILogger::ELL_DEBUG, mtlName.c_str());
 
                 if (ctx.useMaterials && !ctx.useGroups)
                 {
@@ -262,7 +531,7 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
                 }
 			}
 			break;
-		case 'f':               // face
+		case SParsedChunk::SStatement::E_TYPE::FACE:
 		{
 			if (noMaterial && !dummyMaterialCreated)
 			{
@@ -276,78 +545,64 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 				submeshMaterialNames.push_back(NO_MATERIAL_MTL_NAME);
 			}
 
-			SObjVertex v;
-
-			// get all vertices data in this face (current line of obj _file)
-			const std::string wordBuffer = copyLine(bufPtr, bufEnd);
-			const char* linePtr = wordBuffer.c_str();
-			const char* const endPtr = linePtr + wordBuffer.size();
-
-			core::vector<uint32_t> faceCorners;
-			faceCorners.reserve(32ull);
-
-			// read in all vertices
-			linePtr = goNextWord(linePtr, endPtr);
-			while (0 != linePtr[0])
+			// OBJ indices are 1-based, negative ones are relative to the attribute count at the point of the face statement
+			auto resolve = [](const int32_t raw, const size_t base, const uint32_t localCount, const size_t total) -> int64_t
 			{
-				// Array to communicate with retrieveVertexIndices()
-				// sends the buffer sizes and gets the actual indices
-				// if index not set returns -1
-				int32_t Idx[3];
-				Idx[1] = Idx[2] = -1;
-
-				// read in next vertex's data
-				uint32_t wlength = copyWord(tmpbuf, linePtr, WORD_BUFFER_LENGTH, endPtr);
-				// this function will also convert obj's 1-based index to c++'s 0-based index
-				retrieveVertexIndices(tmpbuf, Idx, tmpbuf+wlength+1, vertexBuffer.size(), textureCoordBuffer.size(), normalsBuffer.size());
-				v.pos[0] = vertexBuffer[Idx[0]].data[0];
-				v.pos[1] = vertexBuffer[Idx[0]].data[1];
-				v.pos[2] = vertexBuffer[Idx[0]].data[2];
+				int64_t ix = -1;
+				if (raw>0)
+					ix = raw-1;
+				else if (raw<0)
+					ix = static_cast<int64_t>(base+localCount)+raw;
+				return ix<static_cast<int64_t>(total) ? ix:-1;
+			};
+
+			faceCorners.clear();
+			for (uint32_t c=0u; c<statement.cornerCount; c++)
+			{
+				const auto& corner = chunk.corners[statement.firstCorner+c];
+				const int64_t posIx = resolve(corner.pos,chunk.positionBase,statement.positionCount,vertexBuffer.size());
+				if (posIx<0)
+					continue;
+				const int64_t uvIx = resolve(corner.uv,chunk.uvBase,statement.uvCount,textureCoordBuffer.size());
+				const int64_t normalIx = resolve(corner.normal,chunk.normalBase,statement.normalCount,normalsBuffer.size());
+
+				SVertexKey key;
+				SObjVertex& v = key.vertex;
+				v.pos[0] = vertexBuffer[posIx].data[0];
+				v.pos[1] = vertexBuffer[posIx].data[1];
+				v.pos[2] = vertexBuffer[posIx].data[2];
 				//set texcoord
-				if ( -1 != Idx[1] )
-                {
-					v.uv[0] = textureCoordBuffer[Idx[1]].data[0];
-					v.uv[1] = textureCoordBuffer[Idx[1]].data[1];
-                }
+				if (uvIx>=0)
+				{
+					v.uv[0] = textureCoordBuffer[uvIx].data[0];
+					v.uv[1] = textureCoordBuffer[uvIx].data[1];
+				}
 				else
-                {
+				{
 					v.uv[0] = core::nan<float>();
 					v.uv[1] = core::nan<float>();
-                }
-                //set normal
-				if ( -1 != Idx[2] )
-                {
-					core::vectorSIMDf simdNormal;
-					simdNormal.set(normalsBuffer[Idx[2]].data);
-                    simdNormal.makeSafe3D();
-					v.normal32bit = quantNormalCache->quantize<EF_A2B10G10R10_SNORM_PACK32>(simdNormal);
-                }
+				}
+				//set normal
+				if (normalIx>=0)
+					v.normal32bit = quantizedNormals[normalIx];
 				else
 				{
 					v.normal32bit = core::vectorSIMDu32(0u);
-                    recalcNormals.back() = true;
+					recalcNormals.back() = true;
 				}
+				key.smoothingGroup = smoothingGroup;
 
-				uint32_t ix;
-				auto vtx_ix = map_vtx2ix.find(v);
-				if (vtx_ix != map_vtx2ix.end() && smoothingGroup==vtxSmoothGrp[vtx_ix->second])
-					ix = vtx_ix->second;
-				else
+				auto found = map_vtx2ix.try_emplace(key,static_cast<uint32_t>(vertices.size()));
+				if (found.second)
 				{
-					ix = vertices.size();
 					vertices.push_back(v);
-                    vtxSmoothGrp.push_back(smoothingGroup);
-					map_vtx2ix.insert({v, ix});
+					vtxSmoothGrp.push_back(smoothingGroup);
 				}
-
-				faceCorners.push_back(ix);
-
-				// go to next vertex
-				linePtr = goNextWord(linePtr, endPtr);
+				faceCorners.push_back(found.first->second);
 			}
 
             // triangulate the face
-            for (uint32_t i = 1u; i < faceCorners.size()-1u; ++i)
+            for (uint32_t i = 1u; i+1u < faceCorners.size(); ++i)
             {
                 // Add a triangle
                 performActionBasedOnOrientationSystem
@@ -368,14 +623,8 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
             }
 		}
 		break;
-
-		case '#': // comment
-		default:
-			break;
-		}	// end switch(bufPtr[0])
-		// eat up rest of line
-		bufPtr = goNextLine(bufPtr, bufEnd);
-	}	// end while(bufPtr && (bufPtr-buf<filesize))
+		}
+	}
 
 	// prune out invalid empty shape groups (TODO: convert to AoS and use an erase_if)
 	for (size_t i = 0ull; i < submeshes.size(); ++i)
@@ -528,212 +777,6 @@ asset::SAssetBundle COBJMeshFileLoader::loadAsset(system::IFile* _file, const as
 }
 
 
-//! Read 3d vector of floats
-const char* COBJMeshFileLoader::readVec3(const char* bufPtr, float vec[3], const char* const bufEnd)
-{
-	const uint32_t WORD_BUFFER_LENGTH = 256;
-	char wordBuffer[WORD_BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",vec);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",vec+1);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",vec+2);
-
-    vec[0] = -vec[0]; // change handedness
-	return bufPtr;
-}
-
-
-//! Read 2d vector of floats
-const char* COBJMeshFileLoader::readUV(const char* bufPtr, float vec[2], const char* const bufEnd)
-{
-	const uint32_t WORD_BUFFER_LENGTH = 256;
-	char wordBuffer[WORD_BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",vec);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	sscanf(wordBuffer,"%f",vec+1);
-
-	vec[1] = 1.f-vec[1]; // change handedness
-	return bufPtr;
-}
-
-
-//! Read boolean value represented as 'on' or 'off'
-const char* COBJMeshFileLoader::readBool(const char* bufPtr, bool& tf, const char* const bufEnd)
-{
-	const uint32_t BUFFER_LENGTH = 8;
-	char tfStr[BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(tfStr, bufPtr, BUFFER_LENGTH, bufEnd);
-	tf = strcmp(tfStr, "off") != 0;
-	return bufPtr;
-}
-
-//! skip space characters and stop on first non-space
-const char* COBJMeshFileLoader::goFirstWord(const char* buf, const char* const bufEnd, bool acrossNewlines)
-{
-	// skip space characters
-	if (acrossNewlines)
-		while((buf != bufEnd) && core::isspace(*buf))
-			++buf;
-	else
-		while((buf != bufEnd) && core::isspace(*buf) && (*buf != '\n'))
-			++buf;
-
-	return buf;
-}
-
-
-//! skip current word and stop at beginning of next one
-const char* COBJMeshFileLoader::goNextWord(const char* buf, const char* const bufEnd, bool acrossNewlines)
-{
-	// skip current word
-	while(( buf != bufEnd ) && !core::isspace(*buf))
-		++buf;
-
-	return goFirstWord(buf, bufEnd, acrossNewlines);
-}
-
-
-//! Read until line break is reached and stop at the next non-space character
-const char* COBJMeshFileLoader::goNextLine(const char* buf, const char* const bufEnd)
-{
-	// look for newline characters
-	while(buf != bufEnd)
-	{
-		// found it, so leave
-		if (*buf=='\n' || *buf=='\r')
-			break;
-		++buf;
-	}
-	return goFirstWord(buf, bufEnd);
-}
-
-
-uint32_t COBJMeshFileLoader::copyWord(char* outBuf, const char* const inBuf, uint32_t outBufLength, const char* const bufEnd)
-{
-	if (!outBufLength)
-		return 0;
-	if (!inBuf)
-	{
-		*outBuf = 0;
-		return 0;
-	}
-
-	uint32_t i = 0;
-	while(inBuf[i])
-	{
-		if (core::isspace(inBuf[i]) || &(inBuf[i]) == bufEnd)
-			break;
-		++i;
-	}
-
-	uint32_t length = core::min(i, outBufLength-1);
-	for (uint32_t j=0; j<length; ++j)
-		outBuf[j] = inBuf[j];
-
-	outBuf[length] = 0;
-	return length;
-}
-
-
-std::string COBJMeshFileLoader::copyLine(const char* inBuf, const char* bufEnd)
-{
-	if (!inBuf)
-		return std::string();
-
-	const char* ptr = inBuf;
-	while (ptr<bufEnd)
-	{
-		if (*ptr=='\n' || *ptr=='\r')
-			break;
-		++ptr;
-	}
-	// we must avoid the +1 in case the array is used up
-	return std::string(inBuf, (uint32_t)(ptr-inBuf+((ptr < bufEnd) ? 1 : 0)));
-}
-
-
-const char* COBJMeshFileLoader::goAndCopyNextWord(char* outBuf, const char* inBuf, uint32_t outBufLength, const char* bufEnd)
-{
-	inBuf = goNextWord(inBuf, bufEnd, false);
-	copyWord(outBuf, inBuf, outBufLength, bufEnd);
-	return inBuf;
-}
-
-
-bool COBJMeshFileLoader::retrieveVertexIndices(char* vertexData, int32_t* idx, const char* bufEnd, uint32_t vbsize, uint32_t vtsize, uint32_t vnsize)
-{
-	char word[16] = "";
-	const char* p = goFirstWord(vertexData, bufEnd);
-	uint32_t idxType = 0;	// 0 = posIdx, 1 = texcoordIdx, 2 = normalIdx
-
-	uint32_t i = 0;
-	while ( p != bufEnd )
-	{
-		if ( ( core::isdigit(*p)) || (*p == '-') )
-		{
-			// build up the number
-			word[i++] = *p;
-		}
-		else if ( *p == '/' || *p == ' ' || *p == '\0' )
-		{
-			// number is completed. Convert and store it
-			word[i] = '\0';
-			// if no number was found index will become 0 and later on -1 by decrement
-			sscanf(word,"%d",idx+idxType);
-			if (idx[idxType]<0)
-			{
-				switch (idxType)
-				{
-					case 0:
-						idx[idxType] += vbsize;
-						break;
-					case 1:
-						idx[idxType] += vtsize;
-						break;
-					case 2:
-						idx[idxType] += vnsize;
-						break;
-				}
-			}
-			else
-				idx[idxType]-=1;
-
-			// reset the word
-			word[0] = '\0';
-			i = 0;
-
-			// go to the next kind of index type
-			if (*p == '/')
-			{
-				if ( ++idxType > 2 )
-				{
-					// error checking, shouldn't reach here unless file is wrong
-					idxType = 0;
-				}
-			}
-			else
-			{
-				// set all missing values to disable (=-1)
-				while (++idxType < 3)
-					idx[idxType]=-1;
-				++p;
-				break; // while
-			}
-		}
-
-		// go to the next char
-		++p;
-	}
-
-	return true;
-}
-
 std::string COBJMeshFileLoader::genKeyForMeshBuf(const SContext& _ctx, const std::string& _baseKey, const std::string& _mtlName, const std::string& _grpName) const
 {
     return _baseKey + "?" + _grpName + "?" + _mtlName;
@@ -9,6 +9,7 @@
 
 #include "nbl/system/ISystem.h"
 #include "nbl/system/IFile.h"
+#include "nbl/system/CBufferedFileWriter.h"
 #include "nbl/asset/utils/CMeshManipulator.h"
 
 namespace nbl
@@ -74,7 +75,7 @@ bool CPLYMeshWriter::writeAsset(system::IFile* _file, const SAssetWriteParams& _
 	if (!file || !mesh)
 		return false;
 
-    SContext context = { SAssetWriteContext{ inCtx.params, file} };
+    SContext context = { SAssetWriteContext{ inCtx.params, file}, system::CBufferedFileWriter(file) };
     
     if (meshbuffers.size() > 1)
     {
@@ -212,11 +213,7 @@ bool CPLYMeshWriter::writeAsset(system::IFile* _file, const SAssetWriteParams& _
         faceCount = 0u;
     header += "end_header\n";
 
-    {
-        system::IFile::success_t success;
-        file->write(success, header.c_str(), context.fileOffset, header.size());
-        context.fileOffset += success.getBytesProcessed();
-    }
+    context.output.write(header.c_str(), header.size());
  
     if (flags & asset::EWF_BINARY)
         writeBinary(rawCopyMeshBuffer, vertexCount, faceCount, idxT, indices, forceFaces, vaidToWrite, context);
@@ -225,7 +222,7 @@ bool CPLYMeshWriter::writeAsset(system::IFile* _file, const SAssetWriteParams& _
 
     _NBL_ALIGNED_FREE(const_cast<void*>(indices));
 
-	return true;
+	return context.output.flush();
 }
 
 void CPLYMeshWriter::writeBinary(const asset::ICPUMeshBuffer* _mbuf, size_t _vtxCount, size_t _fcCount, asset::E_INDEX_TYPE _idxType, void* const _indices, bool _forceFaces, const bool _vaidToWrite[4], SContext& context) const
@@ -278,17 +275,9 @@ void CPLYMeshWriter::writeBinary(const asset::ICPUMeshBuffer* _mbuf, size_t _vtx
         uint32_t* ind = (uint32_t*)indices;
         for (size_t i = 0u; i < _fcCount; ++i)
         {
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, &listSize, context.fileOffset, sizeof(listSize));
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(&listSize, sizeof(listSize));
 
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, ind, context.fileOffset, listSize * 4);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(ind, listSize * 4);
 
             ind += listSize;
         }
@@ -298,17 +287,9 @@ void CPLYMeshWriter::writeBinary(const asset::ICPUMeshBuffer* _mbuf, size_t _vtx
         uint16_t* ind = (uint16_t*)indices;
         for (size_t i = 0u; i < _fcCount; ++i)
         {
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, &listSize, context.fileOffset, sizeof(listSize));
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(&listSize, sizeof(listSize));
 
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, ind, context.fileOffset, listSize * 2);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(ind, listSize * 2);
             
             ind += listSize;
         }
@@ -374,11 +355,7 @@ void CPLYMeshWriter::writeText(const asset::ICPUMeshBuffer* _mbuf, size_t _vtxCo
             writefunc(3, i, 3u);
         }
 
-        {
-            system::IFile::success_t success;
-            context.writeContext.outputFile->write(success, "\n", context.fileOffset, 1);
-            context.fileOffset += success.getBytesProcessed();
-        }
+        context.output.write("\n", 1);
     }
 
     const char* listSize = "3 ";
@@ -402,19 +379,11 @@ void CPLYMeshWriter::writeText(const asset::ICPUMeshBuffer* _mbuf, size_t _vtxCo
         uint32_t* ind = (uint32_t*)indices;
         for (size_t i = 0u; i < _fcCount; ++i)
         {
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, listSize, context.fileOffset, 2);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(listSize, 2);
 
             writeVectorAsText(context, ind, 3);
 
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, "\n", context.fileOffset, 1);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write("\n", 1);
 
             ind += 3;
         }
@@ -424,19 +393,11 @@ void CPLYMeshWriter::writeText(const asset::ICPUMeshBuffer* _mbuf, size_t _vtxCo
         uint16_t* ind = (uint16_t*)indices;
         for (size_t i = 0u; i < _fcCount; ++i)
         {
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, listSize, context.fileOffset, 2);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(listSize, 2);
 
             writeVectorAsText(context, ind, 3);
 
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, "\n", context.fileOffset, 1);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write("\n", 1);
 
             ind += 3;
         }
@@ -465,11 +426,7 @@ void CPLYMeshWriter::writeAttribBinary(SContext& context, asset::ICPUMeshBuffer*
             for (uint32_t k = 0u; k < _cpa; ++k)
                 a[k] = ui[k];
 
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, a, context.fileOffset, _cpa);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(a, _cpa);
         }
         else if (bytesPerCh == 2u)
         {
@@ -477,19 +434,11 @@ void CPLYMeshWriter::writeAttribBinary(SContext& context, asset::ICPUMeshBuffer*
             for (uint32_t k = 0u; k < _cpa; ++k)
                 a[k] = ui[k];
 
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, a, context.fileOffset, 2 * _cpa);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(a, 2 * _cpa);
         }
         else if (bytesPerCh == 4u)
         {
-            {
-                system::IFile::success_t success;
-                context.writeContext.outputFile->write(success, ui, context.fileOffset, 4 * _cpa);
-                context.fileOffset += success.getBytesProcessed();
-            }
+            context.output.write(ui, 4 * _cpa);
         }
     }
     else
@@ -498,11 +447,7 @@ void CPLYMeshWriter::writeAttribBinary(SContext& context, asset::ICPUMeshBuffer*
         if (flipAttribute)
             f[0] = -f[0];
 
-        {
-            system::IFile::success_t success;
-            context.writeContext.outputFile->write(success, f.pointer, context.fileOffset, 4 * _cpa);
-            context.fileOffset += success.getBytesProcessed();
-        }
+        context.output.write(f.pointer, 4 * _cpa);
     }
 }
 
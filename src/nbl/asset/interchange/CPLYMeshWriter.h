@@ -10,6 +10,7 @@
 
 #include "nbl/asset/ICPUMeshBuffer.h"
 #include "nbl/asset/interchange/IAssetWriter.h"
+#include "nbl/system/CBufferedFileWriter.h"
 
 namespace nbl
 {
@@ -42,7 +43,7 @@ class CPLYMeshWriter : public asset::IAssetWriter
         struct SContext
         {
             SAssetWriteContext writeContext;
-            size_t fileOffset = 0;
+            system::CBufferedFileWriter output;
         };
 
         void writeBinary(const asset::ICPUMeshBuffer* _mbuf, size_t _vtxCount, size_t _fcCount, asset::E_INDEX_TYPE _idxType, void* const _indices, bool _forceFaces, const bool _vaidToWrite[4], SContext& context) const;
@@ -71,11 +72,7 @@ class CPLYMeshWriter : public asset::IAssetWriter
 
 					ss << std::setprecision(6) << _vec[i] * (currentFlipOnVariable ? -1 : 1) << " ";
 			}
-            auto str = ss.str();
-
-            system::IFile::success_t succ;
-            context.writeContext.outputFile->write(succ, str.c_str(), context.fileOffset, str.size());
-            context.fileOffset += succ.getBytesProcessed();
+            context.output.write(ss.str());
         }
 };
 
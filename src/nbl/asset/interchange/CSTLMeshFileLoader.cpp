@@ -15,6 +15,12 @@
 #include "nbl/system/ISystem.h"
 #include "nbl/system/IFile.h"
 
+#include "nbl/core/execution.h"
+
+#include <charconv>
+#include <numeric>
+#include <thread>
+
 using namespace nbl;
 using namespace nbl::asset;
 
@@ -123,6 +129,87 @@ void CSTLMeshFileLoader::initialize()
 	precomputeAndCachePipeline(false);
 }
 
+namespace
+{
+// one facet with the normal and corners as stored in the file
+struct STriangle
+{
+	float normal[3];
+	float positions[3][3];
+};
+constexpr size_t BinaryHeaderSize = 84ull;
+constexpr size_t BinaryTriangleSize = 50ull;
+
+inline std::string_view nextToken(const char*& ptr, const char* const end)
+{
+	while (ptr!=end && core::isspace(*ptr))
+		++ptr;
+	const char* const tokenBegin = ptr;
+	while (ptr!=end && !core::isspace(*ptr))
+		++ptr;
+	return std::string_view(tokenBegin,ptr-tokenBegin);
+}
+inline bool parseVector(const char*& ptr, const char* const end, float (&out)[3])
+{
+	for (auto i=0; i<3; i++)
+	{
+		const auto token = nextToken(ptr,end);
+		const char* begin = token.data();
+		const char* const tokenEnd = begin+token.size();
+		// `from_chars` doesn't accept an explicit plus sign
+		if (begin!=tokenEnd && *begin=='+')
+			begin++;
+		if (std::from_chars(begin,tokenEnd,out[i]).ec!=std::errc())
+			return false;
+	}
+	return true;
+}
+
+//! Line aligned part of an ASCII STL, always starts at a facet boundary
+struct SASCIIChunk
+{
+	inline void parse()
+	{
+		const char* ptr = begin;
+		auto expect = [&](const std::string_view keyword) -> bool {return nextToken(ptr,end)==keyword;};
+		while (true)
+		{
+			const auto token = nextToken(ptr,end);
+			if (token.empty())
+				return;
+			if (token=="endsolid")
+			{
+				reachedEnd = true;
+				return;
+			}
+			STriangle& triangle = triangles.emplace_back();
+			if (token!="facet" || !expect("normal") || !parseVector(ptr,end,triangle.normal) || !expect("outer") || !expect("loop"))
+			{
+				failed = true;
+				return;
+			}
+			for (auto i=0; i<3; i++)
+			if (!expect("vertex") || !parseVector(ptr,end,triangle.positions[i]))
+			{
+				failed = true;
+				return;
+			}
+			if (!expect("endloop") || !expect("endfacet"))
+			{
+				failed = true;
+				return;
+			}
+		}
+	}
+
+	const char* begin;
+	const char* end;
+	core::vector<STriangle> triangles = {};
+	bool failed = false;
+	bool reachedEnd = false;
+};
+}
+
 SAssetBundle CSTLMeshFileLoader::loadAsset(system::IFile* _file, const IAssetLoader::SAssetLoadParams& _params, IAssetLoader::IAssetLoaderOverride* _override, uint32_t _hierarchyLevel)
 {
 	if (!_file)
@@ -149,147 +236,182 @@ SAssetBundle CSTLMeshFileLoader::loadAsset(system::IFile* _file, const IAssetLoa
 	if (filesize < 6ull) // we need a header
 		return {};
 
-	bool hasColor = false;
-
-	auto mesh = core::make_smart_refctd_ptr<ICPUMesh>();
-	auto meshbuffer = core::make_smart_refctd_ptr<ICPUMeshBuffer>();
-	meshbuffer->setPositionAttributeIx(POSITION_ATTRIBUTE);
-	meshbuffer->setNormalAttributeIx(NORMAL_ATTRIBUTE);
-
-	bool binary = false;
-	std::string token;
-	if (getNextToken(&context, token) != "solid")
-		binary = hasColor = true;
-
-	core::vector<core::vectorSIMDf> positions, normals;
-	core::vector<uint32_t> colors;
-	if (binary)
+	// map the whole file whenever possible instead of reading it piecemeal
+	core::smart_refctd_ptr<system::IFile> mappedFile(_file);
 	{
-		if (_file->getSize() < 80)
+		const system::IFile* constFile = _file;
+		if (!constFile->getMappedPointer())
+		{
+			system::ISystem::future_t<core::smart_refctd_ptr<system::IFile>> future;
+			m_assetMgr->getSystem()->createFile(future,_file->getFileName(),core::bitflag(system::IFile::ECF_READ)|system::IFile::ECF_MAPPABLE);
+			core::smart_refctd_ptr<system::IFile> reopened;
+			if (auto lock=future.acquire())
+				lock.move_into(reopened);
+			if (reopened && reopened->getSize()==filesize)
+				mappedFile = std::move(reopened);
+		}
+	}
+	core::vector<uint8_t> fileContents;
+	const auto* data = reinterpret_cast<const uint8_t*>(static_cast<const system::IFile*>(mappedFile.get())->getMappedPointer());
+	if (!data)
+	{
+		fileContents.resize(filesize);
+		system::IFile::success_t success;
+		_file->read(success, fileContents.data(), 0, filesize);
+		if (!success)
 			return {};
+		data = fileContents.data();
+	}
 
-		constexpr size_t headerOffset = 80; 
-		context.fileOffset = headerOffset; //! skip header
-
-		uint32_t vertexCount = 0u;
+	// plenty of binary exporters start their header with "solid" too, an exact size match is a much stronger hint
+	bool binary = strncmp(reinterpret_cast<const char*>(data),"solid",5u)!=0 || !core::isspace(data[5]);
+	uint32_t triangleCount = 0u;
+	if (filesize>=BinaryHeaderSize)
+	{
+		memcpy(&triangleCount,data+80u,sizeof(triangleCount));
+		if (filesize==BinaryHeaderSize+BinaryTriangleSize*triangleCount)
+			binary = true;
+	}
 
-		system::IFile::success_t success;
-		context.inner.mainFile->read(success, &vertexCount, context.fileOffset, sizeof(vertexCount));
-		if (!success)
+	const bool rightHanded = _params.loaderFlags & E_LOADER_PARAMETER_FLAGS::ELPF_RIGHT_HANDED_MESHES;
+	bool hasColor = false;
+	core::vector<STriangle> asciiTriangles;
+	if (binary)
+	{
+		if (filesize < BinaryHeaderSize)
 			return {};
-		context.fileOffset += sizeof(vertexCount);
+		triangleCount = core::min<size_t>(triangleCount,(filesize-BinaryHeaderSize)/BinaryTriangleSize);
 
-		positions.reserve(3 * vertexCount);
-		normals.reserve(vertexCount);
-		colors.reserve(vertexCount);
+		// assuming VisCam/SolidView non-standard trick to store color in 2 bytes of extra attribute, only used if all facets have it
+		hasColor = triangleCount!=0u;
+		for (uint32_t i=0u; hasColor && i<triangleCount; i++)
+			hasColor = data[BinaryHeaderSize+BinaryTriangleSize*i+BinaryTriangleSize-1u]&0x80u;
 	}
 	else
-		goNextLine(&context); // skip header
-
-	uint16_t attrib = 0u;
-	token.reserve(32);
-	while (context.fileOffset < filesize) // TODO: check it
 	{
-		if (!binary)
+		const char* const textEnd = reinterpret_cast<const char*>(data)+filesize;
+		// skip the "solid name" line
+		const char* textBegin = reinterpret_cast<const char*>(data);
+		while (textBegin!=textEnd && *textBegin!='\n' && *textBegin!='\r')
+			++textBegin;
+
+		// split at facet boundaries so every chunk can be tokenized independently
+		constexpr size_t MinChunkSize = 0x1ull<<20u;
+		const size_t textSize = textEnd-textBegin;
+		const size_t maxChunks = core::max(std::thread::hardware_concurrency(),1u)*4ull;
+		const size_t chunkCount = core::min<size_t>(core::max<size_t>(textSize/MinChunkSize,1ull),maxChunks);
+		const std::string_view text(textBegin,textSize);
+		core::vector<SASCIIChunk> chunks;
+		chunks.reserve(chunkCount);
+		size_t chunkBegin = 0ull;
+		for (size_t i=0ull; i<chunkCount && chunkBegin<textSize; i++)
 		{
-			if (getNextToken(&context, token) != "facet")
+			size_t chunkEnd = textSize;
+			if (i+1ull<chunkCount)
 			{
-				if (token == "endsolid")
-					break;
-				return {};
-			}
-			if (getNextToken(&context, token) != "normal")
-			{
-				return {};
+				constexpr std::string_view EndFacet = "endfacet";
+				chunkEnd = text.find(EndFacet,core::max((textSize*(i+1ull))/chunkCount,chunkBegin));
+				chunkEnd = chunkEnd!=std::string_view::npos ? (chunkEnd+EndFacet.size()):textSize;
 			}
+			chunks.push_back({textBegin+chunkBegin,textBegin+chunkEnd});
+			chunkBegin = chunkEnd;
 		}
+		std::for_each(core::execution::par,chunks.begin(),chunks.end(),[](SASCIIChunk& chunk)->void{chunk.parse();});
 
+		size_t totalTriangles = 0ull;
+		for (const auto& chunk : chunks)
 		{
-			core::vectorSIMDf n;
-			getNextVector(&context, n, binary);
-			if(_params.loaderFlags & E_LOADER_PARAMETER_FLAGS::ELPF_RIGHT_HANDED_MESHES)
-				performActionBasedOnOrientationSystem<float>(n.x, [](float& varToFlip) {varToFlip = -varToFlip;});
-			normals.push_back(core::normalize(n));
-		}
-
-		if (!binary)
-		{
-			if (getNextToken(&context, token) != "outer" || getNextToken(&context, token) != "loop")
+			// the failure of a facet past `endsolid` doesn't matter
+			if (chunk.failed)
 				return {};
+			totalTriangles += chunk.triangles.size();
+			if (chunk.reachedEnd)
+				break;
 		}
-
+		asciiTriangles.reserve(totalTriangles);
+		for (const auto& chunk : chunks)
 		{
-			core::vectorSIMDf p[3];
-			for (uint32_t i = 0u; i < 3u; ++i)
-			{
-				if (!binary)
-				{
-					if (getNextToken(&context, token) != "vertex")
-						return {};
-				}
-				getNextVector(&context, p[i], binary);
-				if (_params.loaderFlags & E_LOADER_PARAMETER_FLAGS::ELPF_RIGHT_HANDED_MESHES)
-					performActionBasedOnOrientationSystem<float>(p[i].x, [](float& varToFlip){varToFlip = -varToFlip; });
-			}
-			for (uint32_t i = 0u; i < 3u; ++i) // seems like in STL format vertices are ordered in clockwise manner...
-				positions.push_back(p[2u - i]);
+			asciiTriangles.insert(asciiTriangles.end(),chunk.triangles.begin(),chunk.triangles.end());
+			if (chunk.reachedEnd)
+				break;
 		}
+		triangleCount = asciiTriangles.size();
+	}
 
-		if (!binary)
-		{
-			if (getNextToken(&context, token) != "endloop" || getNextToken(&context, token) != "endfacet")
-				return {};
-		}
-		else
-		{
-			system::IFile::success_t success;
-			context.inner.mainFile->read(success, &attrib, context.fileOffset, sizeof(attrib));
-			if (!success)
-				return {};
-			context.fileOffset += sizeof(attrib);
-		}
+	auto mesh = core::make_smart_refctd_ptr<ICPUMesh>();
+	auto meshbuffer = core::make_smart_refctd_ptr<ICPUMeshBuffer>();
+	meshbuffer->setPositionAttributeIx(POSITION_ATTRIBUTE);
+	meshbuffer->setNormalAttributeIx(NORMAL_ATTRIBUTE);
 
-		if (hasColor && (attrib & 0x8000u)) // assuming VisCam/SolidView non-standard trick to store color in 2 bytes of extra attribute
-		{
-			const void* srcColor[1]{ &attrib };
-			uint32_t color{};
-			convertColor<EF_A1R5G5B5_UNORM_PACK16, EF_B8G8R8A8_UNORM>(srcColor, &color, 0u, 0u);
-			colors.push_back(color);
-		}
-		else
-		{
-			hasColor = false;
-			colors.clear();
-		}
+	const size_t vertexCount = size_t(triangleCount)*3ull;
+	const size_t vtxSize = hasColor ? (3 * sizeof(float) + 4 + 4) : (3 * sizeof(float) + 4);
+	auto vertexBuf = core::make_smart_refctd_ptr<asset::ICPUBuffer>(vtxSize * vertexCount);
+	uint8_t* const vertexData = reinterpret_cast<uint8_t*>(vertexBuf->getPointer());
 
-		if ((normals.back() == core::vectorSIMDf()).all())
+	// de-interleave the facets straight into the vertex buffer in parallel, only the normal quantization (which goes through a shared cache) stays serial
+	core::vector<core::vectorSIMDf> faceNormals(triangleCount);
+	{
+		constexpr uint32_t TrianglesPerBatch = 0x1u<<14u;
+		core::vector<uint32_t> batches((triangleCount+TrianglesPerBatch-1u)/TrianglesPerBatch);
+		std::iota(batches.begin(),batches.end(),0u);
+		std::for_each(core::execution::par_unseq,batches.begin(),batches.end(),[&](const uint32_t batch)->void
 		{
-			normals.back().set(
-				core::plane3dSIMDf(
-					*(positions.rbegin() + 2),
-					*(positions.rbegin() + 1),
-					*(positions.rbegin() + 0)).getNormal()
-			);
-		}
-	} // end while (_file->getPos() < filesize)
+			const uint32_t last = core::min(triangleCount,(batch+1u)*TrianglesPerBatch);
+			for (uint32_t i=batch*TrianglesPerBatch; i<last; i++)
+			{
+				STriangle triangle;
+				uint16_t attrib = 0u;
+				if (binary)
+				{
+					const uint8_t* const record = data+BinaryHeaderSize+BinaryTriangleSize*i;
+					memcpy(&triangle,record,sizeof(STriangle));
+					memcpy(&attrib,record+sizeof(STriangle),sizeof(attrib));
+				}
+				else
+					triangle = asciiTriangles[i];
 
-	const size_t vtxSize = hasColor ? (3 * sizeof(float) + 4 + 4) : (3 * sizeof(float) + 4);
-	auto vertexBuf = core::make_smart_refctd_ptr<asset::ICPUBuffer>(vtxSize * positions.size());
+				// X gets flipped unless the meshes are requested right handed, W stays 0 for the zero normal check
+				core::vectorSIMDf p[3];
+				for (uint32_t j=0u; j<3u; j++)
+				{
+					p[j] = core::vectorSIMDf(triangle.positions[j][0],triangle.positions[j][1],triangle.positions[j][2]);
+					if (!rightHanded)
+						p[j].x = -p[j].x;
+				}
+				core::vectorSIMDf n(triangle.normal[0],triangle.normal[1],triangle.normal[2]);
+				if (!rightHanded)
+					n.x = -n.x;
+				if ((n==core::vectorSIMDf()).all())
+					n = core::plane3dSIMDf(p[2],p[1],p[0]).getNormal();
+				else
+					n = core::normalize(n);
+				faceNormals[i] = n;
+
+				uint32_t color = 0u;
+				if (hasColor)
+				{
+					const void* srcColor[1]{ &attrib };
+					convertColor<EF_A1R5G5B5_UNORM_PACK16, EF_B8G8R8A8_UNORM>(srcColor, &color, 0u, 0u);
+				}
+				// seems like in STL format vertices are ordered in clockwise manner...
+				for (uint32_t j=0u; j<3u; j++)
+				{
+					uint8_t* const ptr = vertexData+(size_t(i)*3ull+j)*vtxSize;
+					memcpy(ptr,p[2u-j].pointer,3*4);
+					if (hasColor)
+						memcpy(ptr+16,&color,4);
+				}
+			}
+		});
+	}
 
 	using quant_normal_t = CQuantNormalCache::value_type_t<EF_A2B10G10R10_SNORM_PACK32>;
-
-	quant_normal_t normal;
-	for (size_t i = 0u; i < positions.size(); ++i)
 	{
-		if (i % 3 == 0)
-			normal = quantNormalCache->quantize<EF_A2B10G10R10_SNORM_PACK32>(normals[i / 3]);
-		uint8_t* ptr = ((uint8_t*)(vertexBuf->getPointer())) + i * vtxSize;
-		memcpy(ptr, positions[i].pointer, 3 * 4);
-
-		*reinterpret_cast<quant_normal_t*>(ptr + 12) = normal;
-
-		if (hasColor)
-			memcpy(ptr + 16, colors.data() + i / 3, 4);
+		core::vector<quant_normal_t> quantNormals(triangleCount);
+		quantNormalCache->quantizeBatch<EF_A2B10G10R10_SNORM_PACK32>(faceNormals,quantNormals.data());
+		for (uint32_t i=0u; i<triangleCount; i++)
+		for (uint32_t j=0u; j<3u; j++)
+			*reinterpret_cast<quant_normal_t*>(vertexData+(size_t(i)*3ull+j)*vtxSize+12) = quantNormals[i];
 	}
 
 	const IAssetLoader::SAssetLoadContext fakeContext(IAssetLoader::SAssetLoadParams{}, nullptr);
@@ -306,7 +428,7 @@ SAssetBundle CSTLMeshFileLoader::loadAsset(system::IFile* _file, const IAssetLoa
 	meta->placeMeta(0u, mbPipeline.get());
 
 	meshbuffer->setPipeline(std::move(mbPipeline));
-	meshbuffer->setIndexCount(positions.size());
+	meshbuffer->setIndexCount(vertexCount);
 	meshbuffer->setIndexType(asset::EIT_UNKNOWN);
 
 	meshbuffer->setVertexBufferBinding({ 0ul, vertexBuf }, 0);
@@ -348,100 +470,5 @@ bool CSTLMeshFileLoader::isALoadableFileFormat(system::IFile* _file, const syste
 	}
 }
 
-//! Read 3d vector of floats
-void CSTLMeshFileLoader::getNextVector(SContext* context, core::vectorSIMDf& vec, bool binary) const
-{
-	if (binary)
-	{
-		{
-			system::IFile::success_t success;
-			context->inner.mainFile->read(success, &vec.X, context->fileOffset, 4);
-			context->fileOffset += success.getBytesProcessed();
-		}
-		
-		{
-			system::IFile::success_t success;
-			context->inner.mainFile->read(success, &vec.Y, context->fileOffset, 4);
-			context->fileOffset += success.getBytesProcessed();
-		}
-
-		{
-			system::IFile::success_t success;
-			context->inner.mainFile->read(success, &vec.Z, context->fileOffset, 4);
-			context->fileOffset += success.getBytesProcessed();
-		}
-	}
-	else
-	{
-		goNextWord(context);
-		std::string tmp;
-
-		getNextToken(context, tmp);
-		sscanf(tmp.c_str(), "%f", &vec.X);
-		getNextToken(context, tmp);
-		sscanf(tmp.c_str(), "%f", &vec.Y);
-		getNextToken(context, tmp);
-		sscanf(tmp.c_str(), "%f", &vec.Z);
-	}
-	vec.X = -vec.X;
-}
-
-//! Read next word
-const std::string& CSTLMeshFileLoader::getNextToken(SContext* context, std::string& token) const
-{
-	goNextWord(context);
-	char c;
-	token = "";
-
-	while (context->fileOffset != context->inner.mainFile->getSize())
-	{
-		system::IFile::success_t success;
-		context->inner.mainFile->read(success, &c, context->fileOffset, sizeof(c));
-		context->fileOffset += success.getBytesProcessed();
-
-		// found it, so leave
-		if (core::isspace(c))
-			break;
-		token += c;
-	}
-	return token;
-}
-
-//! skip to next word
-void CSTLMeshFileLoader::goNextWord(SContext* context) const
-{
-	uint8_t c;
-	while (context->fileOffset != context->inner.mainFile->getSize()) // TODO: check it
-	{
-		system::IFile::success_t success;
-		context->inner.mainFile->read(success, &c, context->fileOffset, sizeof(c));
-		context->fileOffset += success.getBytesProcessed();
-
-		// found it, so leave
-		if (!core::isspace(c))
-		{
-			context->fileOffset -= success.getBytesProcessed();
-			break;
-		}
-	}
-}
-
-//! Read until line break is reached and stop at the next non-space character
-void CSTLMeshFileLoader::goNextLine(SContext* context) const
-{
-	uint8_t c;
-	// look for newline characters
-	while (context->fileOffset != context->inner.mainFile->getSize()) // TODO: check it
-	{
-		system::IFile::success_t success;
-		context->inner.mainFile->read(success, &c, context->fileOffset, sizeof(c));
-		context->fileOffset += success.getBytesProcessed();
-
-		// found it, so leave
-		if (c == '\n' || c == '\r')
-			break;
-	}
-}
-
 
 #endif // _NBL_COMPILE_WITH_STL_LOADER_
@@ -8,6 +8,7 @@
 
 #include "nbl/asset/ICPUMesh.h"
 #include "nbl/asset/interchange/IAssetWriter.h"
+#include "nbl/system/CBufferedFileWriter.h"
 
 namespace nbl
 {
@@ -42,7 +43,7 @@ class CSTLMeshWriter : public asset::IAssetWriter
         struct SContext
         {
             SAssetWriteContext writeContext;
-            size_t fileOffset;
+            system::CBufferedFileWriter output;
         };
 
         // write binary format
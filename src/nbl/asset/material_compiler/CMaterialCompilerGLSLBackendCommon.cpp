@@ -143,8 +143,7 @@ class ITraversalGenerator
 
 		std::pair<instr_t, const IR::INode*> processSubtree(const IR::INode* tree, IR::INode::children_array_t& next)
 		{
-			// TODO deduplication (find identical IR subtrees, make them share instruction streams), hash consing?
-			// Merkle Tree, LLVM had some nice blogposts about how their LTO works with hashmaps that can match subtrees in the context of type definitions
+			// identical IR subtrees are already shared thanks to the hash consing in `IR::addRootNode`, identical roots get compiled once
 			return CInterpreter::processSubtree(m_ir, tree, next, m_translationCache);
 		}
 
@@ -1212,6 +1211,8 @@ auto CMaterialCompilerGLSLBackendCommon::compile(SContext* _ctx, IR* _ir, E_GENE
 		uint32_t remainingRegisters = instr_stream::MAX_REGISTER_COUNT;
 
 		const size_t interm_bsdf_data_begin_ix = _ctx->bsdfData.size();
+		// roots can share subtrees, but the BxDF data gets resolved against this root's prefetch registers
+		_ctx->bsdfDataIndexMap.clear();
 
 		CIdGenerator id_gen;
 
@@ -43,9 +43,10 @@ namespace nbl::asset::impl
         const IShaderCompiler::CIncludeFinder* m_defaultIncludeFinder;
         const system::ISystem* m_system;
         const uint32_t m_maxInclCnt;
+        core::vector<IShaderCompiler::CIncludeFinder::SDependency>* m_dependencies;
 
     public:
-        Includer(const IShaderCompiler::CIncludeFinder* _inclFinder, const system::ISystem* _fs, uint32_t _maxInclCnt) : m_defaultIncludeFinder(_inclFinder), m_system(_fs), m_maxInclCnt{ _maxInclCnt } {}
+        Includer(const IShaderCompiler::CIncludeFinder* _inclFinder, const system::ISystem* _fs, uint32_t _maxInclCnt, core::vector<IShaderCompiler::CIncludeFinder::SDependency>* _dependencies=nullptr) : m_defaultIncludeFinder(_inclFinder), m_system(_fs), m_maxInclCnt{ _maxInclCnt }, m_dependencies(_dependencies) {}
 
         //_requesting_source in top level #include's is what shaderc::Compiler's compiling functions get as `input_file_name` parameter
         //so in order for properly working relative #include's (""-type) `input_file_name` has to be path to file from which the GLSL source really come from
@@ -98,6 +99,8 @@ namespace nbl::asset::impl
             }
             else
             {
+                if (m_dependencies)
+                    m_dependencies->push_back({relDir,_requested_source,result.absolutePath,result.hash,_type!=shaderc_include_type_relative});
                 auto res_str = std::move(result.contents);
                 //employ encloseWithinExtraInclGuards() in order to prevent infinite loop of (not necesarilly direct) self-inclusions while other # directives (incl guards among them) are disabled
                 IShaderCompiler::disableAllDirectivesExceptIncludes(res_str);
@@ -150,7 +153,7 @@ std::string CGLSLCompiler::preprocessShader(std::string&& code, IShader::E_SHADE
 
     if (preprocessOptions.includeFinder != nullptr)
     {
-        options.SetIncluder(std::make_unique<impl::Includer>(preprocessOptions.includeFinder, m_system.get(), /*maxSelfInclusionCount*/5));//custom #include handler
+        options.SetIncluder(std::make_unique<impl::Includer>(preprocessOptions.includeFinder, m_system.get(), /*maxSelfInclusionCount*/5, preprocessOptions.dependencies));//custom #include handler
     }
     const shaderc_shader_kind scstage = stage == IShader::ESS_UNKNOWN ? shaderc_glsl_infer_from_source : ESStoShadercEnum(stage);
     auto res = comp.PreprocessGlsl(code, scstage, preprocessOptions.sourceIdentifier.data(), options);
@@ -178,6 +181,14 @@ core::smart_refctd_ptr<ICPUShader> CGLSLCompiler::compileToSPIRV(const char* cod
 
     auto newCode = preprocessShader(std::string(code), glslOptions.stage, glslOptions.preprocessorOptions);
 
+    CCache::hash_t cacheKey;
+    if (glslOptions.cache)
+    {
+        cacheKey = getCacheKey(IShader::E_CONTENT_TYPE::ECT_GLSL, newCode, glslOptions.stage, glslOptions);
+        if (auto cachedSpirv = glslOptions.cache->find(cacheKey))
+            return core::make_smart_refctd_ptr<asset::ICPUShader>(std::move(cachedSpirv), glslOptions.stage, IShader::E_CONTENT_TYPE::ECT_SPIRV, glslOptions.preprocessorOptions.sourceIdentifier.data());
+    }
+
     shaderc::Compiler comp;
     shaderc::CompileOptions shadercOptions; //default options
     shadercOptions.SetTargetSpirv(static_cast<shaderc_spirv_version>(glslOptions.targetSpirvVersion));
@@ -194,6 +205,8 @@ core::smart_refctd_ptr<ICPUShader> CGLSLCompiler::compileToSPIRV(const char* cod
 
         if (glslOptions.spirvOptimizer)
             outSpirv = glslOptions.spirvOptimizer->optimize(outSpirv.get(), glslOptions.preprocessorOptions.logger);
+        if (glslOptions.cache)
+            glslOptions.cache->insert(cacheKey, outSpirv.get());
         return core::make_smart_refctd_ptr<asset::ICPUShader>(std::move(outSpirv), glslOptions.stage, IShader::E_CONTENT_TYPE::ECT_SPIRV, glslOptions.preprocessorOptions.sourceIdentifier.data());
     }
     else
@@ -436,6 +436,17 @@ core::smart_refctd_ptr<ICPUShader> CHLSLCompiler::compileToSPIRV(const char* cod
 
     try_upgrade_shader_stage(arguments, stage, logger);
     try_upgrade_hlsl_version(arguments, logger);
+
+    CCache::hash_t cacheKey;
+    if (hlslOptions.cache)
+    {
+        std::wstring joinedArguments;
+        for (const auto& argument : arguments)
+            joinedArguments.append(argument).push_back(L'\0');
+        cacheKey = getCacheKey(IShader::E_CONTENT_TYPE::ECT_HLSL, newCode, stage, hlslOptions, std::string_view(reinterpret_cast<const char*>(joinedArguments.data()), joinedArguments.size() * sizeof(wchar_t)));
+        if (auto cachedSpirv = hlslOptions.cache->find(cacheKey))
+            return core::make_smart_refctd_ptr<asset::ICPUShader>(std::move(cachedSpirv), stage, IShader::E_CONTENT_TYPE::ECT_SPIRV, hlslOptions.preprocessorOptions.sourceIdentifier.data());
+    }
     
     uint32_t argc = arguments.size();
     LPCWSTR* argsArray = new LPCWSTR[argc];
@@ -466,6 +477,9 @@ core::smart_refctd_ptr<ICPUShader> CHLSLCompiler::compileToSPIRV(const char* cod
     if (hlslOptions.spirvOptimizer)
         outSpirv = hlslOptions.spirvOptimizer->optimize(outSpirv.get(), logger);
 
+    if (hlslOptions.cache)
+        hlslOptions.cache->insert(cacheKey, outSpirv.get());
+
     return core::make_smart_refctd_ptr<asset::ICPUShader>(std::move(outSpirv), stage, IShader::E_CONTENT_TYPE::ECT_SPIRV, hlslOptions.preprocessorOptions.sourceIdentifier.data());
 }
 
@@ -16,6 +16,7 @@
 #include "nbl/asset/utils/CSmoothNormalGenerator.h"
 #include "nbl/asset/utils/CForsythVertexCacheOptimizer.h"
 #include "nbl/asset/utils/COverdrawMeshOptimizer.h"
+#include "nbl/asset/utils/CQuadricMeshSimplifier.h"
 
 namespace nbl::asset
 {
@@ -380,7 +381,7 @@ core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::createMeshBufferUniqueP
 }
 
 //
-core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::calculateSmoothNormals(ICPUMeshBuffer* inbuffer, bool makeNewMesh, float epsilon, uint32_t normalAttrID, VxCmpFunction vxcmp)
+core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::calculateSmoothNormals(ICPUMeshBuffer* inbuffer, bool makeNewMesh, float epsilon, uint32_t normalAttrID, VxCmpFunction vxcmp, E_NORMAL_WEIGHTING weighting)
 {
 	if (inbuffer == nullptr)
 	{
@@ -430,7 +431,7 @@ core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::calculateSmoothNormals(
     }
     else
         outbuffer = core::smart_refctd_ptr<ICPUMeshBuffer>(inbuffer);
-	CSmoothNormalGenerator::calculateNormals(outbuffer.get(), epsilon, normalAttrID, vxcmp);
+	CSmoothNormalGenerator::calculateNormals(outbuffer.get(), epsilon, normalAttrID, vxcmp, weighting);
 
 	return outbuffer;
 }
@@ -512,13 +513,11 @@ core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::createMeshBufferWelded(
     if (!vertexCount)
         return nullptr;
 
-    // reset redirect list
-    uint32_t* redirects = new uint32_t[vertexCount];
-
-    uint32_t maxRedirect = 0;
+    core::vector<uint32_t> vertexIDs(vertexCount);
+    std::iota(vertexIDs.begin(),vertexIDs.end(),0u);
 
     uint8_t* epicData = (uint8_t*)_NBL_ALIGNED_MALLOC(vertexSize*vertexCount,_NBL_SIMD_ALIGNMENT);
-    for (auto i=0u; i<vertexCount; i++)
+    std::for_each(core::execution::par_unseq,vertexIDs.begin(),vertexIDs.end(),[&](const uint32_t i) -> void
     {
         uint8_t* currentVertexPtr = epicData+i*vertexSize;
         for (size_t k=0; k<MAX_ATTRIBS; k++)
@@ -531,27 +530,144 @@ core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::createMeshBufferWelded(
             memcpy(currentVertexPtr,sourcePtr,vertexAttrSize[k]);
             currentVertexPtr += vertexAttrSize[k];
         }
+    });
+
+    // Instead of comparing every pair of vertices, bucket them by a key which is equal for any two vertices `cmpVertices` could accept:
+    // the decoded integer attributes hashed exactly, plus the grid cell of the first EEM_POSITIONS attribute with cells twice the epsilon wide.
+    // A vertex within epsilon of another then lies in one of at most 2^3 cells around it, which get probed, and `cmpVertices` has the final say.
+    struct SKeyAttrib
+    {
+        uint32_t offset = 0u;
+        E_FORMAT format = EF_UNKNOWN;
+        uint32_t dims = 0u;
+        core::vectorSIMDf cellSize;
+    } keyAttrib;
+    core::vector<std::pair<uint32_t,E_FORMAT>> exactAttribs; // byte offset into the packed vertex and format
+    {
+        uint32_t offset = 0u;
+        for (uint32_t i=0u; i<MAX_ATTRIBS; i++)
+        {
+            if (!bufferPresent[i])
+                continue;
+            const auto format = inbuffer->getAttribFormat(i);
+            if (isIntegerFormat(format) || isScaledFormat(format))
+                exactAttribs.emplace_back(offset,format);
+            else if (keyAttrib.format==EF_UNKNOWN && _errMetrics[i].method==EEM_POSITIONS)
+            {
+                keyAttrib.offset = offset;
+                keyAttrib.format = format;
+                keyAttrib.dims = core::min(getFormatChannelCount(format),3u);
+                keyAttrib.cellSize = _errMetrics[i].epsilon*2.f;
+            }
+            offset += getTexelOrBlockBytesize(format);
+        }
     }
+    auto getCell = [&keyAttrib](const float value, const uint32_t dim, const float offset) -> int64_t
+    {
+        const float cellSize = keyAttrib.cellSize[dim];
+        // zero epsilon means exact comparison, also make -0 and +0 land in the same cell
+        if (cellSize<=0.f)
+            return std::bit_cast<int32_t>(value+0.f);
+        return static_cast<int64_t>(std::floor((double(value)+double(offset))/double(cellSize)));
+    };
+    auto getExactHash = [&](const uint8_t* vertex) -> size_t
+    {
+        size_t seed = 0ull;
+        for (const auto& attrib : exactAttribs)
+        {
+            uint32_t decoded[4] = {};
+            ICPUMeshBuffer::getAttribute(decoded,vertex+attrib.first,attrib.second);
+            for (uint32_t c=0u; c<getFormatChannelCount(attrib.second); c++)
+                core::hash_combine(seed,decoded[c]);
+        }
+        return seed;
+    };
+    auto getKey = [&keyAttrib](size_t seed, const int64_t* cell) -> size_t
+    {
+        for (uint32_t d=0u; d<keyAttrib.dims; d++)
+            core::hash_combine(seed,cell[d]);
+        return seed;
+    };
+
+    // (key,vertex) sorted by key then vertex
+    core::vector<std::pair<size_t,uint32_t>> sortedKeys(vertexCount);
+    core::vector<size_t> exactHashes(vertexCount);
+    std::for_each(core::execution::par_unseq,vertexIDs.begin(),vertexIDs.end(),[&](const uint32_t i) -> void
+    {
+        const uint8_t* vertex = epicData+vertexSize*i;
+        exactHashes[i] = getExactHash(vertex);
+        int64_t cell[3] = {};
+        if (keyAttrib.dims)
+        {
+            core::vectorSIMDf value;
+            ICPUMeshBuffer::getAttribute(value,vertex+keyAttrib.offset,keyAttrib.format);
+            for (uint32_t d=0u; d<keyAttrib.dims; d++)
+                cell[d] = getCell(value[d],d,0.f);
+        }
+        sortedKeys[i] = {getKey(exactHashes[i],cell),i};
+    });
+    std::sort(core::execution::par_unseq,sortedKeys.begin(),sortedKeys.end());
 
-    for (auto i=0u; i<vertexCount; i++)
+    // every vertex gets redirected to the lowest other vertex it compares equal to, same as a brute force search would pick
+    core::vector<uint32_t> redirects(vertexCount);
+    std::for_each(core::execution::par,vertexIDs.begin(),vertexIDs.end(),[&](const uint32_t i) -> void
     {
+        const uint8_t* vertex = epicData+vertexSize*i;
+        // per dimension the cells containing `value-epsilon` and `value+epsilon`, which are either equal or neighbours
+        int64_t cellRange[3][2] = {};
+        if (keyAttrib.dims)
+        {
+            core::vectorSIMDf value;
+            ICPUMeshBuffer::getAttribute(value,vertex+keyAttrib.offset,keyAttrib.format);
+            for (uint32_t d=0u; d<keyAttrib.dims; d++)
+            {
+                const float halfCell = keyAttrib.cellSize[d]*0.5f;
+                cellRange[d][0] = getCell(value[d],d,-halfCell);
+                cellRange[d][1] = getCell(value[d],d,halfCell);
+            }
+        }
+
         uint32_t redir = i;
-        for (auto j=0u; j<vertexCount; ++j) // TODO: Use spatial hash for this like in the smooth normal computation @Przemog
+        size_t probedKeys[8];
+        uint32_t probedKeyCount = 0u;
+        for (uint32_t corner=0u; corner<(0x1u<<keyAttrib.dims); corner++)
         {
-            if (i == j)
+            int64_t cell[3];
+            for (uint32_t d=0u; d<keyAttrib.dims; d++)
+                cell[d] = cellRange[d][(corner>>d)&0x1u];
+            const size_t key = getKey(exactHashes[i],cell);
+            if (std::find(probedKeys,probedKeys+probedKeyCount,key)!=probedKeys+probedKeyCount)
                 continue;
-            if (cmpfunc(epicData+vertexSize*i, epicData+vertexSize*j))
+            probedKeys[probedKeyCount++] = key;
+
+            auto it = std::lower_bound(sortedKeys.begin(),sortedKeys.end(),std::pair<size_t,uint32_t>(key,0u));
+            // candidates come in increasing vertex order, so the first match is the lowest in this cell
+            for (; it!=sortedKeys.end() && it->first==key && it->second<redir; it++)
             {
-                redir = j;
+                const uint32_t j = it->second;
+                if (i!=j && cmpfunc(vertex,epicData+vertexSize*j))
+                {
+                    redir = j;
+                    break;
+                }
+            }
+        }
+        // a brute force search considers higher vertices too, only when no lower one exists
+        if (redir==i)
+        for (uint32_t c=0u; c<probedKeyCount; c++)
+        {
+            auto it = std::upper_bound(sortedKeys.begin(),sortedKeys.end(),std::pair<size_t,uint32_t>(probedKeys[c],i));
+            for (; it!=sortedKeys.end() && it->first==probedKeys[c] && (redir==i || it->second<redir); it++)
+            if (cmpfunc(vertex,epicData+vertexSize*it->second))
+            {
+                redir = it->second;
                 break;
             }
         }
-
         redirects[i] = redir;
-        if (redir>maxRedirect)
-            maxRedirect = redir;
-    }
+    });
     _NBL_ALIGNED_FREE(epicData);
+    const uint32_t maxRedirect = *std::max_element(redirects.begin(),redirects.end());
 
     void* oldIndices = inbuffer->getIndices();
     core::smart_refctd_ptr<ICPUMeshBuffer> clone;
@@ -611,7 +727,6 @@ core::smart_refctd_ptr<ICPUMeshBuffer> IMeshManipulator::createMeshBufferWelded(
         for (size_t i=0; i<inbuffer->getIndexCount(); i++)
             indicesOut[i] = redirects[i];
     }
-    delete [] redirects;
 
     if (makeNewMesh)
         return clone;
@@ -1511,6 +1626,237 @@ core::smart_refctd_ptr<ICPUBuffer> IMeshManipulator::idxBufferFromTrianglesFanTo
 	return nullptr;
 }
 
+IMeshManipulator::SMeshletData IMeshManipulator::createMeshlets(const ICPUMeshBuffer* meshbuffer, const SMeshletParams& params)
+{
+	SMeshletData retval;
+	if (!meshbuffer || !meshbuffer->getPipeline())
+		return retval;
+	if (params.maxVertices<3u || params.maxVertices>256u || params.maxTriangles==0u)
+		return retval;
+	switch (meshbuffer->getPipeline()->getCachedCreationParams().primitiveAssembly.primitiveType)
+	{
+		case EPT_TRIANGLE_LIST:
+		case EPT_TRIANGLE_STRIP:
+		case EPT_TRIANGLE_FAN:
+			break;
+		default:
+			return retval;
+	}
+
+	uint32_t triangleCount;
+	if (!getPolyCount(triangleCount,meshbuffer) || triangleCount==0u)
+		return retval;
+
+	// greedy scan, a triangle opens a new meshlet as soon as it would break one of the limits
+	{
+		constexpr uint16_t invalidLocalIx = 0xffffu;
+		core::vector<uint16_t> localIx(upperBoundVertexID(meshbuffer),invalidLocalIx);
+
+		retval.vertices.reserve(core::min<size_t>(size_t(triangleCount)*3u,localIx.size()+localIx.size()/2u));
+		retval.triangles.reserve(size_t(triangleCount)*3u);
+		SMeshlet current = {0u,0u,0u,0u};
+		auto finishMeshlet = [&]() -> void
+		{
+			if (!current.triangleCount)
+				return;
+			for (uint32_t i=0u; i<current.vertexCount; i++)
+				localIx[retval.vertices[current.vertexOffset+i]] = invalidLocalIx;
+			retval.meshlets.push_back(current);
+			current = {static_cast<uint32_t>(retval.vertices.size()),static_cast<uint32_t>(retval.triangles.size()),0u,0u};
+		};
+
+		for (uint32_t i=0u; i<triangleCount; i++)
+		{
+			const auto triangle = getTriangleIndices(meshbuffer,i);
+			if (triangle[0]==triangle[1] || triangle[1]==triangle[2] || triangle[2]==triangle[0])
+				continue;
+			if (triangle[0]>=localIx.size() || triangle[1]>=localIx.size() || triangle[2]>=localIx.size())
+				continue;
+
+			uint32_t newVertices = 0u;
+			for (auto vertexID : triangle)
+				newVertices += localIx[vertexID]==invalidLocalIx ? 1u:0u;
+			if (current.vertexCount+newVertices>params.maxVertices || current.triangleCount==params.maxTriangles)
+				finishMeshlet();
+
+			for (auto vertexID : triangle)
+			{
+				if (localIx[vertexID]==invalidLocalIx)
+				{
+					localIx[vertexID] = static_cast<uint16_t>(current.vertexCount++);
+					retval.vertices.push_back(vertexID);
+				}
+				retval.triangles.push_back(static_cast<uint8_t>(localIx[vertexID]));
+			}
+			current.triangleCount++;
+		}
+		finishMeshlet();
+	}
+
+	// bounding spheres and normal cones are independent per meshlet
+	retval.bounds.resize(retval.meshlets.size());
+	std::for_each(core::execution::par,retval.meshlets.begin(),retval.meshlets.end(),[&](const SMeshlet& meshlet) -> void
+	{
+		auto& bounds = retval.bounds[&meshlet-retval.meshlets.data()];
+
+		core::vectorSIMDf positions[256];
+		for (uint32_t i=0u; i<meshlet.vertexCount; i++)
+			positions[i] = meshbuffer->getPosition(retval.vertices[meshlet.vertexOffset+i]);
+		auto distanceSq = [](const core::vectorSIMDf& a, const core::vectorSIMDf& b) -> float
+		{
+			const core::vectorSIMDf diff = a-b;
+			return core::dot(diff,diff).x;
+		};
+		auto findFarthest = [&](const core::vectorSIMDf& from) -> const core::vectorSIMDf&
+		{
+			uint32_t farthest = 0u;
+			for (uint32_t i=1u; i<meshlet.vertexCount; i++)
+			if (distanceSq(positions[i],from)>distanceSq(positions[farthest],from))
+				farthest = i;
+			return positions[farthest];
+		};
+
+		// Ritter's sphere
+		const auto& a = findFarthest(positions[0]);
+		const auto& b = findFarthest(a);
+		core::vectorSIMDf center = (a+b)*0.5f;
+		float radius = core::sqrt(distanceSq(a,b))*0.5f;
+		for (uint32_t i=0u; i<meshlet.vertexCount; i++)
+		{
+			const float distance = core::sqrt(distanceSq(positions[i],center));
+			if (distance>radius)
+			{
+				const float newRadius = (radius+distance)*0.5f;
+				center += (positions[i]-center)*((newRadius-radius)/distance);
+				radius = newRadius;
+			}
+		}
+		center.w = 0.f;
+		bounds.boundingSphere = center;
+		bounds.boundingSphere.w = radius;
+
+		bounds.coneApex = center;
+		bounds.coneAxis = core::vectorSIMDf(0.f);
+		bounds.coneCutoff = 1.f;
+
+		const uint8_t* triangles = retval.triangles.data()+meshlet.triangleOffset;
+		core::vector<core::vectorSIMDf> normals(meshlet.triangleCount);
+		core::vectorSIMDf normalSum(0.f);
+		for (uint32_t i=0u; i<meshlet.triangleCount; i++)
+		{
+			const auto& p0 = positions[triangles[i*3u+0u]];
+			core::vectorSIMDf normal = core::cross(positions[triangles[i*3u+1u]]-p0,positions[triangles[i*3u+2u]]-p0);
+			normal.w = 0.f;
+			const float area = core::length(normal).x;
+			normals[i] = area>0.f ? normal/area:core::vectorSIMDf(0.f);
+			normalSum += normals[i];
+		}
+		const float sumLength = core::length(normalSum).x;
+		if (sumLength<=0.f)
+			return;
+		const core::vectorSIMDf axis = normalSum/sumLength;
+
+		float minDot = 1.f;
+		for (const auto& normal : normals)
+		if (core::dot(normal,normal).x>0.f)
+			minDot = core::min(minDot,core::dot(normal,axis).x);
+		// normals span more than a hemisphere
+		if (minDot<=0.f)
+			return;
+
+		// slide the apex back along the axis until it is behind every triangle's plane
+		float maxT = 0.f;
+		for (uint32_t i=0u; i<meshlet.triangleCount; i++)
+		{
+			const float normalDotAxis = core::dot(normals[i],axis).x;
+			if (normalDotAxis<=0.f)
+				continue;
+			maxT = core::max(maxT,core::dot(center-positions[triangles[i*3u]],normals[i]).x/normalDotAxis);
+		}
+		bounds.coneApex = center-axis*maxT;
+		bounds.coneAxis = axis;
+		bounds.coneCutoff = core::sqrt(1.f-minDot*minDot);
+	});
+
+	return retval;
+}
+
+core::vector<IMeshManipulator::SMeshletData> IMeshManipulator::createMeshlets(const ICPUMesh* mesh, const SMeshletParams& params)
+{
+	if (!mesh)
+		return {};
+
+	const auto meshbuffers = mesh->getMeshBuffers();
+	core::vector<SMeshletData> retval(meshbuffers.size());
+	std::transform(core::execution::par,meshbuffers.begin(),meshbuffers.end(),retval.begin(),[&params](const ICPUMeshBuffer* meshbuffer) -> SMeshletData
+	{
+		return createMeshlets(meshbuffer,params);
+	});
+	return retval;
+}
+
+core::vector<IMeshManipulator::SLoDLevel> IMeshManipulator::createLoDChain(const ICPUMeshBuffer* meshbuffer, const SLoDChainParams& params)
+{
+	core::vector<SLoDLevel> retval;
+	if (params.triangleRatio<=0.f || params.triangleRatio>=1.f)
+		return retval;
+
+	CQuadricMeshSimplifier simplifier(meshbuffer,params.lockBorders,params.minNormalDot);
+	if (!simplifier.isValid())
+		return retval;
+
+	// the levels only get new index buffers, everything else is shared with the input
+	core::smart_refctd_ptr<ICPURenderpassIndependentPipeline> listPipeline;
+	{
+		const auto* oldPipeline = meshbuffer->getPipeline();
+		if (oldPipeline->getCachedCreationParams().primitiveAssembly.primitiveType!=EPT_TRIANGLE_LIST)
+		{
+			listPipeline = core::smart_refctd_ptr_static_cast<ICPURenderpassIndependentPipeline>(oldPipeline->clone(0u));
+			listPipeline->getCachedCreationParams().primitiveAssembly.primitiveType = EPT_TRIANGLE_LIST;
+		}
+	}
+
+	retval.reserve(params.levelCount);
+	uint32_t triangleCount = simplifier.getTriangleCount();
+	for (uint32_t level=0u; level<params.levelCount; level++)
+	{
+		const uint32_t targetTriangleCount = core::max(static_cast<uint32_t>(float(triangleCount)*params.triangleRatio),1u);
+		const float error = simplifier.simplify(targetTriangleCount,params.maxError);
+		const auto& indices = simplifier.getIndices();
+		if (indices.empty() || simplifier.getTriangleCount()>=triangleCount)
+			break;
+		triangleCount = simplifier.getTriangleCount();
+
+		auto& out = retval.emplace_back();
+		out.error = error;
+		out.meshbuffer = core::move_and_static_cast<ICPUMeshBuffer>(meshbuffer->clone(0u));
+		if (listPipeline)
+			out.meshbuffer->setPipeline(core::smart_refctd_ptr(listPipeline));
+
+		const uint32_t maxIndex = *std::max_element(indices.begin(),indices.end());
+		const bool use16bit = maxIndex<0xffffu;
+		auto indexBuffer = core::make_smart_refctd_ptr<ICPUBuffer>(indices.size()*(use16bit ? sizeof(uint16_t):sizeof(uint32_t)));
+		if (use16bit)
+			std::copy(indices.begin(),indices.end(),reinterpret_cast<uint16_t*>(indexBuffer->getPointer()));
+		else
+			std::copy(indices.begin(),indices.end(),reinterpret_cast<uint32_t*>(indexBuffer->getPointer()));
+		out.meshbuffer->setIndexBufferBinding({0ull,std::move(indexBuffer)});
+		out.meshbuffer->setIndexType(use16bit ? EIT_16BIT:EIT_32BIT);
+		out.meshbuffer->setIndexCount(static_cast<uint32_t>(indices.size()));
+	}
+	return retval;
+}
+
+core::vector<core::vector<IMeshManipulator::SLoDLevel>> IMeshManipulator::createLoDChains(const core::SRange<const ICPUMeshBuffer* const>& meshbuffers, const SLoDChainParams& params)
+{
+	core::vector<core::vector<SLoDLevel>> retval(meshbuffers.size());
+	std::transform(core::execution::par,meshbuffers.begin(),meshbuffers.end(),retval.begin(),[&params](const ICPUMeshBuffer* meshbuffer) -> core::vector<SLoDLevel>
+	{
+		return createLoDChain(meshbuffer,params);
+	});
+	return retval;
+}
+
 float IMeshManipulator::DistanceToLine(core::vectorSIMDf P0, core::vectorSIMDf P1, core::vectorSIMDf InPoint) 
 {
     core::vectorSIMDf PointToStart = InPoint - P0;
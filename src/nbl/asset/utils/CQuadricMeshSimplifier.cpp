@@ -0,0 +1,399 @@
+// Copyright (C) 2018-2020 - DevSH Graphics Programming Sp. z O.O.
+// This file is part of the "Nabla Engine".
+// For conditions of distribution and use, see copyright notice in nabla.h
+
+#include "nbl/core/declarations.h"
+#include "nbl/core/execution.h"
+
+#include "CQuadricMeshSimplifier.h"
+
+#include <numeric>
+#include <algorithm>
+
+#include "nbl/asset/utils/IMeshManipulator.h"
+
+namespace nbl::asset
+{
+
+// border planes are weighted up so open edges hold their shape when they are allowed to move
+static constexpr double BorderQuadricWeight = 10.0;
+
+CQuadricMeshSimplifier::SQuadric CQuadricMeshSimplifier::SQuadric::fromPlane(const core::vectorSIMDf& normal, const float distance, const double weight)
+{
+	SQuadric retval;
+	const double nx = normal.x, ny = normal.y, nz = normal.z, d = distance;
+	retval.a00 = weight*nx*nx;
+	retval.a01 = weight*nx*ny;
+	retval.a02 = weight*nx*nz;
+	retval.a11 = weight*ny*ny;
+	retval.a12 = weight*ny*nz;
+	retval.a22 = weight*nz*nz;
+	retval.b0 = weight*nx*d;
+	retval.b1 = weight*ny*d;
+	retval.b2 = weight*nz*d;
+	retval.c = weight*d*d;
+	retval.weight = weight;
+	return retval;
+}
+
+CQuadricMeshSimplifier::SQuadric& CQuadricMeshSimplifier::SQuadric::operator+=(const SQuadric& other)
+{
+	a00 += other.a00;
+	a01 += other.a01;
+	a02 += other.a02;
+	a11 += other.a11;
+	a12 += other.a12;
+	a22 += other.a22;
+	b0 += other.b0;
+	b1 += other.b1;
+	b2 += other.b2;
+	c += other.c;
+	weight += other.weight;
+	return *this;
+}
+
+double CQuadricMeshSimplifier::SQuadric::evaluate(const core::vectorSIMDf& p) const
+{
+	if (weight<=0.0)
+		return 0.0;
+
+	const double x = p.x, y = p.y, z = p.z;
+	const double rx = a00*x+a01*y+a02*z+b0;
+	const double ry = a01*x+a11*y+a12*z+b1;
+	const double rz = a02*x+a12*y+a22*z+b2;
+	// p^T A p + 2 b^T p + c
+	const double retval = rx*x+ry*y+rz*z+(b0*x+b1*y+b2*z)+c;
+	return core::max(retval,0.0)/weight;
+}
+
+CQuadricMeshSimplifier::CQuadricMeshSimplifier(const ICPUMeshBuffer* _meshbuffer, const bool _lockBorders, const float _minNormalDot) : m_minNormalDot(_minNormalDot)
+{
+	if (!_meshbuffer || !_meshbuffer->getPipeline())
+		return;
+	switch (_meshbuffer->getPipeline()->getCachedCreationParams().primitiveAssembly.primitiveType)
+	{
+		case EPT_TRIANGLE_LIST:
+		case EPT_TRIANGLE_STRIP:
+		case EPT_TRIANGLE_FAN:
+			break;
+		default:
+			return;
+	}
+	uint32_t triangleCount;
+	if (!IMeshManipulator::getPolyCount(triangleCount,_meshbuffer) || triangleCount==0u)
+		return;
+
+	const uint32_t vertexCount = IMeshManipulator::upperBoundVertexID(_meshbuffer);
+	m_positions.resize(vertexCount);
+	for (uint32_t i=0u; i<vertexCount; i++)
+	{
+		m_positions[i] = _meshbuffer->getPosition(i);
+		m_positions[i].w = 0.f;
+	}
+
+	// vertices which are duplicates in every attribute are merged, the ones differing in anything but position form seams
+	core::vector<uint32_t> canonical(vertexCount);
+	{
+		uint32_t enabledAttributes[ICPUMeshBuffer::MAX_VERTEX_ATTRIB_COUNT];
+		uint32_t enabledAttributeCount = 0u;
+		for (uint32_t attr=0u; attr<ICPUMeshBuffer::MAX_VERTEX_ATTRIB_COUNT; attr++)
+		if (_meshbuffer->isAttributeEnabled(attr) && _meshbuffer->getAttribPointer(attr))
+			enabledAttributes[enabledAttributeCount++] = attr;
+
+		auto getAttributeBytes = [&](const uint32_t attr, const uint32_t vertex) -> std::string_view
+		{
+			const auto* ptr = reinterpret_cast<const char*>(_meshbuffer->getAttribPointer(attr))+size_t(vertex)*_meshbuffer->getAttribStride(attr);
+			return std::string_view(ptr,getTexelOrBlockBytesize(_meshbuffer->getAttribFormat(attr)));
+		};
+		core::vector<size_t> hashes(vertexCount);
+		for (uint32_t i=0u; i<vertexCount; i++)
+		{
+			size_t seed = 0ull;
+			for (uint32_t j=0u; j<enabledAttributeCount; j++)
+				core::hash_combine(seed,getAttributeBytes(enabledAttributes[j],i));
+			hashes[i] = seed;
+		}
+		auto sameVertex = [&](const uint32_t a, const uint32_t b) -> bool
+		{
+			for (uint32_t j=0u; j<enabledAttributeCount; j++)
+			if (getAttributeBytes(enabledAttributes[j],a)!=getAttributeBytes(enabledAttributes[j],b))
+				return false;
+			return true;
+		};
+
+		core::vector<uint32_t> order(vertexCount);
+		std::iota(order.begin(),order.end(),0u);
+		std::sort(order.begin(),order.end(),[&hashes](const uint32_t a, const uint32_t b) -> bool {return hashes[a]<hashes[b] || hashes[a]==hashes[b]&&a<b;});
+		for (auto runBegin=order.begin(); runBegin!=order.end();)
+		{
+			const auto runEnd = std::find_if(runBegin,order.end(),[&](const uint32_t v) -> bool {return hashes[v]!=hashes[*runBegin];});
+			for (auto it=runBegin; it!=runEnd; it++)
+			{
+				canonical[*it] = *it;
+				for (auto prev=runBegin; prev!=it; prev++)
+				if (canonical[*prev]==*prev && sameVertex(*prev,*it))
+				{
+					canonical[*it] = *prev;
+					break;
+				}
+			}
+			runBegin = runEnd;
+		}
+
+		// exact position match
+		auto positionLess = [this](const uint32_t a, const uint32_t b) -> bool
+		{
+			const auto& pa = m_positions[a];
+			const auto& pb = m_positions[b];
+			if (pa.x!=pb.x)
+				return pa.x<pb.x;
+			if (pa.y!=pb.y)
+				return pa.y<pb.y;
+			return pa.z<pb.z;
+		};
+		std::sort(order.begin(),order.end(),positionLess);
+		m_positionID.resize(vertexCount);
+		uint32_t positionCount = 0u;
+		for (uint32_t i=0u; i<vertexCount; i++)
+		{
+			if (i && positionLess(order[i-1u],order[i]))
+				positionCount++;
+			m_positionID[order[i]] = positionCount;
+		}
+		m_quadrics.resize(vertexCount ? (positionCount+1u):0u);
+	}
+
+	m_indices.reserve(size_t(triangleCount)*3u);
+	for (uint32_t i=0u; i<triangleCount; i++)
+	{
+		auto triangle = IMeshManipulator::getTriangleIndices(_meshbuffer,i);
+		if (triangle[0]>=vertexCount || triangle[1]>=vertexCount || triangle[2]>=vertexCount)
+			continue;
+		for (auto& vertex : triangle)
+			vertex = canonical[vertex];
+		const auto p0 = m_positionID[triangle[0]], p1 = m_positionID[triangle[1]], p2 = m_positionID[triangle[2]];
+		if (p0==p1 || p1==p2 || p2==p0)
+			continue;
+		m_indices.insert(m_indices.end(),triangle.begin(),triangle.end());
+	}
+
+	classifyVertices(_lockBorders);
+	computeQuadrics(_lockBorders);
+}
+
+void CQuadricMeshSimplifier::classifyVertices(const bool lockBorders)
+{
+	m_kinds.resize(m_positions.size(),EVK_MANIFOLD);
+
+	// seams, positions referenced through more than one vertex
+	{
+		constexpr uint32_t invalidVertex = ~0u;
+		core::vector<uint32_t> positionOwner(m_quadrics.size(),invalidVertex);
+		for (const auto vertex : m_indices)
+		{
+			auto& owner = positionOwner[m_positionID[vertex]];
+			if (owner==invalidVertex)
+				owner = vertex;
+			else if (owner!=vertex)
+				m_kinds[owner] = m_kinds[vertex] = EVK_LOCKED;
+		}
+	}
+
+	m_directedEdges.reserve(m_indices.size());
+	for (size_t i=0u; i<m_indices.size(); i+=3u)
+	for (uint32_t e=0u; e<3u; e++)
+	{
+		const uint32_t a = m_indices[i+e], b = m_indices[i+(e+1u)%3u];
+		// same oriented edge twice is non-manifold
+		if (!m_directedEdges.insert(edgeKey(m_positionID[a],m_positionID[b])).second)
+			m_kinds[a] = m_kinds[b] = EVK_LOCKED;
+	}
+
+	for (size_t i=0u; i<m_indices.size(); i+=3u)
+	for (uint32_t e=0u; e<3u; e++)
+	{
+		const uint32_t a = m_indices[i+e], b = m_indices[i+(e+1u)%3u];
+		if (!isBorderEdge(a,b))
+			continue;
+		for (const auto vertex : {a,b})
+		if (m_kinds[vertex]==EVK_MANIFOLD)
+			m_kinds[vertex] = lockBorders ? EVK_LOCKED:EVK_BORDER;
+	}
+}
+
+void CQuadricMeshSimplifier::computeQuadrics(const bool lockBorders)
+{
+	for (size_t i=0u; i<m_indices.size(); i+=3u)
+	{
+		const uint32_t* triangle = m_indices.data()+i;
+		const auto& p0 = m_positions[triangle[0]];
+		const auto& p1 = m_positions[triangle[1]];
+		const auto& p2 = m_positions[triangle[2]];
+
+		core::vectorSIMDf normal = core::cross(p1-p0,p2-p0);
+		const float doubleArea = core::length(normal).x;
+		if (doubleArea<=0.f)
+			continue;
+		normal /= doubleArea;
+
+		const auto quadric = SQuadric::fromPlane(normal,-core::dot(normal,p0).x,doubleArea*0.5);
+		for (uint32_t e=0u; e<3u; e++)
+			m_quadrics[m_positionID[triangle[e]]] += quadric;
+
+		if (lockBorders)
+			continue;
+		// constrain open edges with a plane perpendicular to the face
+		for (uint32_t e=0u; e<3u; e++)
+		{
+			const uint32_t a = triangle[e], b = triangle[(e+1u)%3u];
+			if (!isBorderEdge(a,b))
+				continue;
+			const core::vectorSIMDf edge = m_positions[b]-m_positions[a];
+			core::vectorSIMDf borderNormal = core::cross(edge,normal);
+			const float borderNormalLength = core::length(borderNormal).x;
+			if (borderNormalLength<=0.f)
+				continue;
+			borderNormal /= borderNormalLength;
+
+			const auto borderQuadric = SQuadric::fromPlane(borderNormal,-core::dot(borderNormal,m_positions[a]).x,core::dot(edge,edge).x*BorderQuadricWeight);
+			m_quadrics[m_positionID[a]] += borderQuadric;
+			m_quadrics[m_positionID[b]] += borderQuadric;
+		}
+	}
+}
+
+bool CQuadricMeshSimplifier::isBorderEdge(const uint32_t a, const uint32_t b) const
+{
+	const auto pa = m_positionID[a], pb = m_positionID[b];
+	return m_directedEdges.find(edgeKey(pb,pa))==m_directedEdges.end() || m_directedEdges.find(edgeKey(pa,pb))==m_directedEdges.end();
+}
+
+bool CQuadricMeshSimplifier::flipsTriangles(const uint32_t from, const uint32_t to, const uint32_t* adjacencyOffsets, const uint32_t* adjacency) const
+{
+	const auto& target = m_positions[to];
+	for (uint32_t i=adjacencyOffsets[from]; i<adjacencyOffsets[from+1u]; i++)
+	{
+		const uint32_t* triangle = m_indices.data()+adjacency[i];
+		// triangles on the collapsed edge vanish, no need to check them
+		if (m_positionID[triangle[0]]==m_positionID[to] || m_positionID[triangle[1]]==m_positionID[to] || m_positionID[triangle[2]]==m_positionID[to])
+			continue;
+
+		core::vectorSIMDf before[3], after[3];
+		for (uint32_t e=0u; e<3u; e++)
+		{
+			before[e] = m_positions[triangle[e]];
+			after[e] = triangle[e]==from ? target:before[e];
+		}
+		const core::vectorSIMDf normalBefore = core::cross(before[1]-before[0],before[2]-before[0]);
+		const core::vectorSIMDf normalAfter = core::cross(after[1]-after[0],after[2]-after[0]);
+		const float lengths = core::length(normalBefore).x*core::length(normalAfter).x;
+		if (core::dot(normalBefore,normalAfter).x<m_minNormalDot*lengths)
+			return true;
+	}
+	return false;
+}
+
+float CQuadricMeshSimplifier::simplify(const uint32_t targetTriangleCount, const float maxError)
+{
+	const double maxErrorSq = double(maxError)*double(maxError);
+	const uint32_t vertexCount = static_cast<uint32_t>(m_positions.size());
+
+	core::vector<uint32_t> adjacencyOffsets(vertexCount+1u);
+	core::vector<uint32_t> adjacency;
+	core::vector<SCollapse> collapses;
+	core::vector<uint32_t> remap(vertexCount);
+	core::vector<uint8_t> touched(vertexCount);
+	// every pass collapses an independent set of edges, cheapest first, then rebuilds the index buffer
+	while (getTriangleCount()>targetTriangleCount)
+	{
+		// vertex to triangle adjacency
+		std::fill(adjacencyOffsets.begin(),adjacencyOffsets.end(),0u);
+		for (const auto vertex : m_indices)
+			adjacencyOffsets[vertex+1u]++;
+		std::inclusive_scan(adjacencyOffsets.begin(),adjacencyOffsets.end(),adjacencyOffsets.begin());
+		adjacency.resize(m_indices.size());
+		{
+			core::vector<uint32_t> cursor(adjacencyOffsets.begin(),adjacencyOffsets.end()-1);
+			for (uint32_t i=0u; i<m_indices.size(); i++)
+				adjacency[cursor[m_indices[i]]++] = i-i%3u;
+		}
+
+		// collapses change which edges are open
+		m_directedEdges.clear();
+		for (size_t i=0u; i<m_indices.size(); i+=3u)
+		for (uint32_t e=0u; e<3u; e++)
+			m_directedEdges.insert(edgeKey(m_positionID[m_indices[i+e]],m_positionID[m_indices[i+(e+1u)%3u]]));
+
+		collapses.clear();
+		for (size_t i=0u; i<m_indices.size(); i+=3u)
+		for (uint32_t e=0u; e<3u; e++)
+		{
+			const uint32_t a = m_indices[i+e], b = m_indices[i+(e+1u)%3u];
+			for (const auto& [from,to] : {std::pair{a,b},std::pair{b,a}})
+			{
+				const auto kind = m_kinds[from];
+				if (kind==EVK_LOCKED || kind==EVK_BORDER && !isBorderEdge(from,to))
+					continue;
+				SQuadric quadric = m_quadrics[m_positionID[from]];
+				quadric += m_quadrics[m_positionID[to]];
+				collapses.push_back({from,to,static_cast<float>(quadric.evaluate(m_positions[to]))});
+			}
+		}
+		std::sort(core::execution::par_unseq,collapses.begin(),collapses.end());
+
+		std::iota(remap.begin(),remap.end(),0u);
+		std::fill(touched.begin(),touched.end(),0u);
+		const uint32_t trianglesToRemove = getTriangleCount()-targetTriangleCount;
+		uint32_t removedTriangles = 0u;
+		bool collapsedAny = false;
+		for (const auto& collapse : collapses)
+		{
+			if (collapse.error>maxErrorSq)
+				break;
+			if (touched[collapse.from] || touched[collapse.to])
+				continue;
+			if (flipsTriangles(collapse.from,collapse.to,adjacencyOffsets.data(),adjacency.data()))
+				continue;
+
+			remap[collapse.from] = collapse.to;
+			// lock the whole one-ring so the remaining checks of the pass see the current geometry
+			for (uint32_t i=adjacencyOffsets[collapse.from]; i<adjacencyOffsets[collapse.from+1u]; i++)
+			{
+				const uint32_t* triangle = m_indices.data()+adjacency[i];
+				bool vanishes = false;
+				for (uint32_t e=0u; e<3u; e++)
+				{
+					touched[triangle[e]] = 1u;
+					vanishes = vanishes || m_positionID[triangle[e]]==m_positionID[collapse.to];
+				}
+				if (vanishes)
+					removedTriangles++;
+			}
+			touched[collapse.to] = 1u;
+			m_quadrics[m_positionID[collapse.to]] += m_quadrics[m_positionID[collapse.from]];
+			m_maxErrorSq = core::max(m_maxErrorSq,collapse.error);
+			collapsedAny = true;
+			if (removedTriangles>=trianglesToRemove)
+				break;
+		}
+		if (!collapsedAny)
+			break;
+
+		size_t outIx = 0u;
+		for (size_t i=0u; i<m_indices.size(); i+=3u)
+		{
+			const uint32_t a = remap[m_indices[i+0u]], b = remap[m_indices[i+1u]], c = remap[m_indices[i+2u]];
+			const auto pa = m_positionID[a], pb = m_positionID[b], pc = m_positionID[c];
+			if (pa==pb || pb==pc || pc==pa)
+				continue;
+			m_indices[outIx++] = a;
+			m_indices[outIx++] = b;
+			m_indices[outIx++] = c;
+		}
+		m_indices.resize(outIx);
+	}
+
+	return core::sqrt(m_maxErrorSq);
+}
+
+}
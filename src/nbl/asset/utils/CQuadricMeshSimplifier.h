@@ -0,0 +1,84 @@
+// Copyright (C) 2018-2020 - DevSH Graphics Programming Sp. z O.O.
+// This file is part of the "Nabla Engine".
+// For conditions of distribution and use, see copyright notice in nabla.h
+
+#ifndef __NBL_ASSET_C_QUADRIC_MESH_SIMPLIFIER_H_INCLUDED__
+#define __NBL_ASSET_C_QUADRIC_MESH_SIMPLIFIER_H_INCLUDED__
+
+#include "nbl/asset/ICPUMeshBuffer.h"
+
+// Edge collapse scheme after Garland & Heckbert "Surface Simplification Using Quadric Error Metrics",
+// vertex classification and pass structure similar to zeux's meshoptimizer (https://github.com/zeux/meshoptimizer) available under MIT license
+
+namespace nbl
+{
+namespace asset
+{
+
+//! Stateful simplifier, every `simplify` call continues from where the previous one stopped so the quadrics keep accumulating along a LoD chain
+class CQuadricMeshSimplifier
+{
+	public:
+		CQuadricMeshSimplifier(const ICPUMeshBuffer* _meshbuffer, const bool _lockBorders, const float _minNormalDot);
+
+		//! False for non-triangle or empty meshbuffers
+		inline bool isValid() const {return !m_indices.empty();}
+
+		inline uint32_t getTriangleCount() const {return static_cast<uint32_t>(m_indices.size()/3u);}
+		//! Triangle list indices into the original meshbuffer's vertices
+		inline const core::vector<uint32_t>& getIndices() const {return m_indices;}
+
+		//! Collapses edges until there are at most `targetTriangleCount` triangles left or the next collapse would deviate more than `maxError`.
+		/** @returns square root of the largest area weighted mean quadric error of all collapses performed so far, an estimate of the object space distance and not a bound */
+		float simplify(const uint32_t targetTriangleCount, const float maxError);
+
+	private:
+		//! symmetric 4x4 matrix of the sum of squared distances to a set of planes, weighted
+		struct SQuadric
+		{
+			double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0;
+			double weight = 0.0;
+
+			static SQuadric fromPlane(const core::vectorSIMDf& normal, const float distance, const double weight);
+
+			SQuadric& operator+=(const SQuadric& other);
+			//! mean squared distance of `p` to the planes
+			double evaluate(const core::vectorSIMDf& p) const;
+		};
+		struct SCollapse
+		{
+			uint32_t from;
+			uint32_t to;
+			float error;
+
+			inline bool operator<(const SCollapse& other) const {return error<other.error;}
+		};
+		enum E_VERTEX_KIND : uint8_t
+		{
+			EVK_MANIFOLD,
+			EVK_BORDER,
+			EVK_LOCKED
+		};
+
+		void classifyVertices(const bool lockBorders);
+		void computeQuadrics(const bool lockBorders);
+		bool isBorderEdge(const uint32_t a, const uint32_t b) const;
+		bool flipsTriangles(const uint32_t from, const uint32_t to, const uint32_t* adjacencyOffsets, const uint32_t* adjacency) const;
+
+		static inline uint64_t edgeKey(const uint32_t a, const uint32_t b) {return (uint64_t(a)<<32ull)|b;}
+
+		core::vector<uint32_t> m_indices;
+		core::vector<core::vectorSIMDf> m_positions; //!< per vertex
+		core::vector<uint32_t> m_positionID; //!< vertices sharing a position share the id
+		core::vector<E_VERTEX_KIND> m_kinds; //!< per vertex
+		core::vector<SQuadric> m_quadrics; //!< per position id
+		core::unordered_set<uint64_t> m_directedEdges; //!< of position ids, used to find the open edges
+		float m_minNormalDot;
+		float m_maxErrorSq = 0.f;
+};
+
+}
+}
+
+#endif
@@ -3,28 +3,20 @@
 // For conditions of distribution and use, see copyright notice in nabla.h
 
 #include "nbl/core/declarations.h"
+#include "nbl/core/execution.h"
 
 #include "CSmoothNormalGenerator.h"
 
 #include <iostream>
 #include <algorithm>
 #include <array>
+#include <numeric>
 
 namespace nbl
 {
 namespace asset
 {
 
-static inline bool operator<(uint32_t lhs, const IMeshManipulator::SSNGVertexData& rhs)
-{
-	return lhs < rhs.hash;
-}
-
-static inline bool operator<(const IMeshManipulator::SSNGVertexData& lhs, uint32_t rhs)
-{
-	return lhs.hash < rhs;
-}
-
 static inline bool compareVertexPosition(const core::vectorSIMDf& a, const core::vectorSIMDf& b, float epsilon)
 {
 	const core::vectorSIMDf difference = core::abs(b - a);
@@ -51,9 +43,9 @@ static inline core::vector3df_SIMD getAngleWeight(const core::vector3df_SIMD & v
 		acosf((b - c + a) / (2.f * bsqrt * asqrt)));
 }
 
-core::smart_refctd_ptr<asset::ICPUMeshBuffer> nbl::asset::CSmoothNormalGenerator::calculateNormals(asset::ICPUMeshBuffer * buffer, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction vxcmp)
+core::smart_refctd_ptr<asset::ICPUMeshBuffer> nbl::asset::CSmoothNormalGenerator::calculateNormals(asset::ICPUMeshBuffer * buffer, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction vxcmp, IMeshManipulator::E_NORMAL_WEIGHTING weighting)
 {
-	VertexHashMap vertexArray = setupData(buffer, epsilon);
+	VertexHashMap vertexArray = setupData(buffer, epsilon, weighting);
 	processConnectedVertices(buffer, vertexArray, epsilon, normalAttrID, vxcmp);
 
 	return core::smart_refctd_ptr<asset::ICPUMeshBuffer>(buffer);
@@ -65,8 +57,9 @@ CSmoothNormalGenerator::VertexHashMap::VertexHashMap(size_t _vertexCount, uint32
 {
 	assert((core::isPoT(hashTableMaxSize)));
 
-	vertices.reserve(_vertexCount);
-	buckets.reserve(_hashTableMaxSize + 1);
+	// second half is scratch for the radix sort
+	vertices.resize(_vertexCount*2ull);
+	buckets.resize(_hashTableMaxSize + 1);
 }
 
 uint32_t CSmoothNormalGenerator::VertexHashMap::hash(const IMeshManipulator::SSNGVertexData & vertex) const
@@ -93,29 +86,12 @@ uint32_t CSmoothNormalGenerator::VertexHashMap::hash(const core::vector3du32_SIM
 		(position.z * primeNumber3))& (hashTableMaxSize - 1);
 }
 
-void CSmoothNormalGenerator::VertexHashMap::add(IMeshManipulator::SSNGVertexData && vertex)
-{
-	vertex.hash = hash(vertex);
-	vertices.push_back(vertex);
-}
-
-CSmoothNormalGenerator::VertexHashMap::BucketBounds CSmoothNormalGenerator::VertexHashMap::getBucketBoundsByHash(uint32_t hash)
+CSmoothNormalGenerator::VertexHashMap::BucketBounds CSmoothNormalGenerator::VertexHashMap::getBucketBoundsByHash(uint32_t hash) const
 {
 	if (hash == invalidHash)
 		return { vertices.end(), vertices.end() };
 
-	core::vector<IMeshManipulator::SSNGVertexData>::iterator begin = std::lower_bound(vertices.begin(), vertices.end(), hash);
-	core::vector<IMeshManipulator::SSNGVertexData>::iterator end = std::upper_bound(vertices.begin(), vertices.end(), hash);
-
-	//bucket missing
-	if (begin == vertices.end())
-		return { vertices.end(), vertices.end() };
-
-	//bucket missing
-	if (begin->hash != hash)
-		return { vertices.end(), vertices.end() };
-
-	return { begin, end };
+	return { vertices.begin() + buckets[hash], vertices.begin() + buckets[hash + 1] };
 }
 
 struct KeyAccessor
@@ -130,45 +106,41 @@ struct KeyAccessor
 };
 void CSmoothNormalGenerator::VertexHashMap::validate()
 {
-	const auto oldSize = vertices.size();
-	vertices.resize(oldSize*2u);
-	// TODO: maybe use counting sort (or big radix) and use the histogram directly for the buckets
-	auto finalSortedOutput = core::radix_sort(vertices.data(),vertices.data()+oldSize,oldSize,KeyAccessor());
+	const auto vertexCount = vertices.size()/2u;
+	std::for_each(core::execution::par_unseq, vertices.begin(), vertices.begin()+vertexCount, [this](IMeshManipulator::SSNGVertexData& vertex) -> void
+	{
+		vertex.hash = hash(vertex);
+	});
+
+	// stable, so vertices within a bucket keep their index buffer order
+	auto finalSortedOutput = core::radix_sort(vertices.data(),vertices.data()+vertexCount,vertexCount,KeyAccessor());
 	// TODO: optimize out the erase
 	if (finalSortedOutput!=vertices.data())
-		vertices.erase(vertices.begin(),vertices.begin()+oldSize);
+		vertices.erase(vertices.begin(),vertices.begin()+vertexCount);
 	else
-		vertices.erase(vertices.begin()+oldSize,vertices.end());
+		vertices.erase(vertices.begin()+vertexCount,vertices.end());
 
-	// TODO: are `buckets` even begin USED!?
-	uint16_t prevHash = vertices[0].hash;
-	core::vector<IMeshManipulator::SSNGVertexData>::iterator prevBegin = vertices.begin();
-	buckets.push_back(prevBegin);
-
-	while (true)
-	{
-		core::vector<IMeshManipulator::SSNGVertexData>::iterator next = std::upper_bound(prevBegin, vertices.end(), prevHash);
-		buckets.push_back(next);
-
-		if (next == vertices.end())
-			break;
-
-		prevBegin = next;
-		prevHash = next->hash;
-	}
+	// hashes are bounded by the table size, so the bucket starts are an exclusive prefix sum of a histogram
+	std::fill(buckets.begin(),buckets.end(),0u);
+	for (const auto& vertex : vertices)
+		buckets[vertex.hash+1u]++;
+	std::inclusive_scan(buckets.begin(),buckets.end(),buckets.begin());
 }
 
-CSmoothNormalGenerator::VertexHashMap CSmoothNormalGenerator::setupData(const asset::ICPUMeshBuffer* buffer, float epsilon)
+CSmoothNormalGenerator::VertexHashMap CSmoothNormalGenerator::setupData(const asset::ICPUMeshBuffer* buffer, float epsilon, IMeshManipulator::E_NORMAL_WEIGHTING weighting)
 {
 	const size_t idxCount = buffer->getIndexCount();
 	_NBL_DEBUG_BREAK_IF((idxCount % 3));
+	const uint32_t triangleCount = idxCount / 3u;
 
-	VertexHashMap vertices(idxCount, std::min(16u * 1024u, core::roundUpToPoT<unsigned int>(idxCount * 1.0f / 32.0f)), epsilon == 0.0f ? 0.00001f : epsilon * 1.00001f);
+	VertexHashMap vertices(triangleCount * 3u, std::min(16u * 1024u, core::roundUpToPoT<unsigned int>(idxCount * 1.0f / 32.0f)), epsilon == 0.0f ? 0.00001f : epsilon * 1.00001f);
 
-	core::vector3df_SIMD faceNormal;
-
-	for (uint32_t i = 0; i < idxCount; i += 3)
+	core::vector<uint32_t> triangles(triangleCount);
+	std::iota(triangles.begin(), triangles.end(), 0u);
+	IMeshManipulator::SSNGVertexData* const outVertices = vertices.getVertices();
+	std::for_each(core::execution::par_unseq, triangles.begin(), triangles.end(), [&](const uint32_t triangle) -> void
 	{
+		const uint32_t i = triangle * 3u;
 		const uint32_t ix[3]{
 			buffer->getIndexValue(i),
 			buffer->getIndexValue(i + 1),
@@ -179,59 +151,58 @@ CSmoothNormalGenerator::VertexHashMap CSmoothNormalGenerator::setupData(const as
 		core::vectorSIMDf v2 = buffer->getPosition(ix[1]);
 		core::vectorSIMDf v3 = buffer->getPosition(ix[2]);
 
-		faceNormal = core::cross(v2 - v1, v3 - v1);
-		faceNormal = core::normalize(faceNormal);
+		const core::vector3df_SIMD crossProduct = core::cross(v2 - v1, v3 - v1);
+		const core::vector3df_SIMD faceNormal = core::normalize(crossProduct);
 
 		//set data for vertices
-		core::vector3df_SIMD angleWages = getAngleWeight(v1, v2, v3);
+		core::vector3df_SIMD wages;
+		if (weighting == IMeshManipulator::ENW_AREA)
+			wages = core::vector3df_SIMD(core::length(crossProduct)[0] * 0.5f);
+		else
+			wages = getAngleWeight(v1, v2, v3);
 
-		vertices.add({ i,		0,	angleWages.x,	v1,		faceNormal });
-		vertices.add({ i + 1,	0,	angleWages.y,	v2,		faceNormal });
-		vertices.add({ i + 2,	0,	angleWages.z,	v3,		faceNormal });
-	}
+		outVertices[i] = { i,			0,	wages.x,	v1,		faceNormal };
+		outVertices[i + 1] = { i + 1,	0,	wages.y,	v2,		faceNormal };
+		outVertices[i + 2] = { i + 2,	0,	wages.z,	v3,		faceNormal };
+	});
 
 	vertices.validate();
 
 	return vertices;
 }
 
-void CSmoothNormalGenerator::processConnectedVertices(asset::ICPUMeshBuffer * buffer, VertexHashMap & vertexHashMap, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction vxcmp)
+void CSmoothNormalGenerator::processConnectedVertices(asset::ICPUMeshBuffer * buffer, const VertexHashMap & vertexHashMap, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction vxcmp)
 {
-	for (uint32_t cell = 0; cell < vertexHashMap.getBucketCount() - 1; cell++)
+	// the meshbuffer has unique primitives, so every vertex writes a different normal and they can all run concurrently,
+	// vertices are sorted by cell so neighbouring work items touch the same buckets
+	const auto& sortedVertices = vertexHashMap.getSortedVertices();
+	std::for_each(core::execution::par, sortedVertices.begin(), sortedVertices.end(), [&](const IMeshManipulator::SSNGVertexData& processedVertex) -> void
 	{
-		VertexHashMap::BucketBounds processedBucket = vertexHashMap.getBucketBoundsById(cell);
+		std::array<uint32_t, 8> neighboringCells = vertexHashMap.getNeighboringCellHashes(processedVertex);
+		core::vector3df_SIMD normal = processedVertex.parentTriangleFaceNormal * processedVertex.wage;
 
-		for (core::vector<IMeshManipulator::SSNGVertexData>::iterator processedVertex = processedBucket.begin; processedVertex != processedBucket.end; processedVertex++)
+		//iterate among all neighboring cells
+		for (int i = 0; i < 8; i++)
 		{
-			std::array<uint32_t, 8> neighboringCells = vertexHashMap.getNeighboringCellHashes(*processedVertex);
-			core::vector3df_SIMD normal = processedVertex->parentTriangleFaceNormal * processedVertex->wage;
-
-			//iterate among all neighboring cells
-			for (int i = 0; i < 8; i++)
+			VertexHashMap::BucketBounds bounds = vertexHashMap.getBucketBoundsByHash(neighboringCells[i]);
+			for (; bounds.begin != bounds.end; bounds.begin++)
 			{
-				VertexHashMap::BucketBounds bounds = vertexHashMap.getBucketBoundsByHash(neighboringCells[i]);
-				for (; bounds.begin != bounds.end; bounds.begin++)
-				{
-					if (processedVertex != bounds.begin)
-						if (compareVertexPosition(processedVertex->position, bounds.begin->position, epsilon) &&
-							vxcmp(*processedVertex, *bounds.begin, buffer))
-						{
-							//TODO: better mean calculation algorithm
-							normal += bounds.begin->parentTriangleFaceNormal * bounds.begin->wage;
-						}
-				}
+				if (&processedVertex != &*bounds.begin)
+					if (compareVertexPosition(processedVertex.position, bounds.begin->position, epsilon) &&
+						vxcmp(processedVertex, *bounds.begin, buffer))
+					{
+						//TODO: better mean calculation algorithm
+						normal += bounds.begin->parentTriangleFaceNormal * bounds.begin->wage;
+					}
 			}
-
-
-			normal = core::normalize(core::vectorSIMDf(normal));
-			buffer->setAttribute(normal, normalAttrID, buffer->getIndexValue(processedVertex->indexOffset));
 		}
-	}
-
 
+		normal = core::normalize(core::vectorSIMDf(normal));
+		buffer->setAttribute(normal, normalAttrID, buffer->getIndexValue(processedVertex.indexOffset));
+	});
 }
 
-std::array<uint32_t, 8> CSmoothNormalGenerator::VertexHashMap::getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData & vertex)
+std::array<uint32_t, 8> CSmoothNormalGenerator::VertexHashMap::getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData & vertex) const
 {
 	std::array<uint32_t, 8> neighbourhood;
 
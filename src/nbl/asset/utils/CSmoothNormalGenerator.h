@@ -23,7 +23,7 @@ namespace asset
 class CSmoothNormalGenerator
 {
 public:
-	static core::smart_refctd_ptr<asset::ICPUMeshBuffer> calculateNormals(asset::ICPUMeshBuffer* buffer, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction function);
+	static core::smart_refctd_ptr<asset::ICPUMeshBuffer> calculateNormals(asset::ICPUMeshBuffer* buffer, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction function, IMeshManipulator::E_NORMAL_WEIGHTING weighting = IMeshManipulator::ENW_ANGLE);
 
 	CSmoothNormalGenerator() = delete;
 	~CSmoothNormalGenerator() = delete;
@@ -34,32 +34,31 @@ private:
 	public:
 		struct BucketBounds
 		{
-			core::vector<IMeshManipulator::SSNGVertexData>::iterator begin;
-			core::vector<IMeshManipulator::SSNGVertexData>::iterator end;
+			core::vector<IMeshManipulator::SSNGVertexData>::const_iterator begin;
+			core::vector<IMeshManipulator::SSNGVertexData>::const_iterator end;
 		};
 
 	public:
 		VertexHashMap(size_t _vertexCount, uint32_t _hashTableMaxSize, float _cellSize);
 
-		//inserts vertex into hash table
-		void add(IMeshManipulator::SSNGVertexData&& vertex);
+		//vertices get filled in place, possibly from many threads, then `validate` has to be called
+		inline IMeshManipulator::SSNGVertexData* getVertices() { return vertices.data(); }
 
-		//sorts hashtable and sets iterators at beginnings of bucktes
+		//sets the cell hash of every vertex, sorts them by it and records where each bucket begins
 		void validate();
 
 		//
-		std::array<uint32_t, 8> getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData& vertex);
+		std::array<uint32_t, 8> getNeighboringCellHashes(const IMeshManipulator::SSNGVertexData& vertex) const;
 
-		inline uint32_t getBucketCount() const { return buckets.size(); }
-		inline BucketBounds getBucketBoundsById(uint32_t index) { return { buckets[index], buckets[index + 1] }; }
-		BucketBounds getBucketBoundsByHash(uint32_t hash);
+		inline const core::vector<IMeshManipulator::SSNGVertexData>& getSortedVertices() const { return vertices; }
+		BucketBounds getBucketBoundsByHash(uint32_t hash) const;
 
 	private:
 		static constexpr uint32_t invalidHash = 0xFFFFFFFF;
 
 	private:
-		//holds iterators pointing to beginning of each bucket, last iterator points to vertices.end()
-		core::vector<core::vector<IMeshManipulator::SSNGVertexData>::iterator> buckets;
+		//offset of the first vertex of every bucket, indexed by hash, last element is the vertex count
+		core::vector<uint32_t> buckets;
 		core::vector<IMeshManipulator::SSNGVertexData> vertices;
 		const uint32_t hashTableMaxSize;
 		const float cellSize;
@@ -71,8 +70,8 @@ private:
 	};
 
 private:
-	static VertexHashMap setupData(const asset::ICPUMeshBuffer* buffer, float epsilon);
-	static void processConnectedVertices(asset::ICPUMeshBuffer* buffer, VertexHashMap& vertices, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction vxcmp);
+	static VertexHashMap setupData(const asset::ICPUMeshBuffer* buffer, float epsilon, IMeshManipulator::E_NORMAL_WEIGHTING weighting);
+	static void processConnectedVertices(asset::ICPUMeshBuffer* buffer, const VertexHashMap& vertices, float epsilon, uint32_t normalAttrID, IMeshManipulator::VxCmpFunction vxcmp);
 
 };
 
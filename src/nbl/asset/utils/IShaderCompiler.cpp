@@ -4,6 +4,7 @@
 #include "nbl/asset/utils/IShaderCompiler.h"
 #include "nbl/asset/utils/shadercUtils.h"
 #include "nbl/asset/utils/CGLSLVirtualTexturingBuiltinIncludeGenerator.h"
+#include "nbl/system/CBufferedFileWriter.h"
 
 #include <sstream>
 #include <regex>
@@ -189,6 +190,19 @@ IShaderCompiler::CIncludeFinder::CIncludeFinder(core::smart_refctd_ptr<system::I
 // @param requestingSourceDir: the directory where the incude was requested
 // @param includeName: the string within <> of the include preprocessing directive
 auto IShaderCompiler::CIncludeFinder::getIncludeStandard(const system::path& requestingSourceDir, const std::string& includeName) const -> IIncludeLoader::found_t
+{
+    return getCachedInclude(true,requestingSourceDir,includeName);
+}
+
+// ! includes within ""
+// @param requestingSourceDir: the directory where the incude was requested
+// @param includeName: the string within "" of the include preprocessing directive
+auto IShaderCompiler::CIncludeFinder::getIncludeRelative(const system::path& requestingSourceDir, const std::string& includeName) const -> IIncludeLoader::found_t
+{
+    return getCachedInclude(false,requestingSourceDir,includeName);
+}
+
+auto IShaderCompiler::CIncludeFinder::resolveIncludeStandard(const system::path& requestingSourceDir, const std::string& includeName) const -> IIncludeLoader::found_t
 {
     if (auto contents = tryIncludeGenerators(includeName)) 
         return contents;
@@ -197,21 +211,67 @@ auto IShaderCompiler::CIncludeFinder::getIncludeStandard(const system::path& req
     return m_defaultFileSystemLoader->getInclude(requestingSourceDir.string(),includeName);
 }
 
-// ! includes within ""
-// @param requestingSourceDir: the directory where the incude was requested
-// @param includeName: the string within "" of the include preprocessing directive
-auto IShaderCompiler::CIncludeFinder::getIncludeRelative(const system::path& requestingSourceDir, const std::string& includeName) const -> IIncludeLoader::found_t
+auto IShaderCompiler::CIncludeFinder::resolveIncludeRelative(const system::path& requestingSourceDir, const std::string& includeName) const -> IIncludeLoader::found_t
 {
     if (auto contents = m_defaultFileSystemLoader->getInclude(requestingSourceDir.string(),includeName))
         return contents;
     return trySearchPaths(includeName);
 }
 
+static std::optional<std::filesystem::file_time_type> getModificationTime(const system::path& path)
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(path,ec);
+    if (ec)
+        return std::nullopt;
+    return time;
+}
+
+auto IShaderCompiler::CIncludeFinder::getCachedInclude(const bool standard, const system::path& requestingSourceDir, const std::string& includeName) const -> IIncludeLoader::found_t
+{
+    std::string key;
+    key.reserve(requestingSourceDir.native().size()+includeName.size()+2);
+    key.push_back(standard ? '<':'"');
+    key += requestingSourceDir.generic_string();
+    key.push_back('\0');
+    key += includeName;
+
+    {
+        std::shared_lock lock(m_cacheMutex);
+        auto found = m_cache.find(key);
+        // a file changed on disk since we've read it invalidates the entry, otherwise only the stat was paid for
+        if (found!=m_cache.end() && (!found->second.modificationTime || getModificationTime(found->second.absolutePath)==found->second.modificationTime))
+            return {found->second.absolutePath,found->second.contents,found->second.hash};
+    }
+
+    auto retval = standard ? resolveIncludeStandard(requestingSourceDir,includeName):resolveIncludeRelative(requestingSourceDir,includeName);
+    if (!retval)
+        return {};
+    retval.hash = core::XXHash_256(reinterpret_cast<const uint8_t*>(retval.contents.data()),retval.contents.size());
+
+    std::unique_lock lock(m_cacheMutex);
+    m_cache.insert_or_assign(std::move(key),SCachedInclude{retval.absolutePath,retval.contents,retval.hash,getModificationTime(retval.absolutePath)});
+    return retval;
+}
+
+bool IShaderCompiler::CIncludeFinder::isUpToDate(const SDependency& dependency) const
+{
+    const auto found = getCachedInclude(dependency.standardInclude,dependency.requestingSourceDir,dependency.includeName);
+    return found && found.absolutePath==dependency.absolutePath && found.hash==dependency.hash;
+}
+
+void IShaderCompiler::CIncludeFinder::clearCache()
+{
+    std::unique_lock lock(m_cacheMutex);
+    m_cache.clear();
+}
+
 void IShaderCompiler::CIncludeFinder::addSearchPath(const std::string& searchPath, const core::smart_refctd_ptr<IIncludeLoader>& loader)
 {
     if (!loader)
         return;
     m_loaders.push_back(LoaderSearchPath{ loader, searchPath });
+    clearCache();
 }
 
 void IShaderCompiler::CIncludeFinder::addGenerator(const core::smart_refctd_ptr<IIncludeGenerator>& generatorToAdd)
@@ -228,6 +288,7 @@ void IShaderCompiler::CIncludeFinder::addGenerator(const core::smart_refctd_ptr<
         });
 
     m_generators.insert(found, generatorToAdd);
+    clearCache();
 }
 
 auto IShaderCompiler::CIncludeFinder::trySearchPaths(const std::string& includeName) const -> IIncludeLoader::found_t
@@ -289,3 +350,177 @@ auto IShaderCompiler::CIncludeFinder::tryIncludeGenerators(const std::string& in
 
     return {};
 }
+
+auto IShaderCompiler::getCacheKey(const IShader::E_CONTENT_TYPE contentType, const std::string_view preprocessedCode, const IShader::E_SHADER_STAGE stage, const SCompilerOptions& options, const std::string_view compilerArguments) -> CCache::hash_t
+{
+    std::string keyData;
+    auto append = [&keyData](const auto& value) -> void
+    {
+        keyData.append(reinterpret_cast<const char*>(&value),sizeof(value));
+    };
+    auto appendString = [&](const std::string_view str) -> void
+    {
+        append(uint64_t(str.size()));
+        keyData.append(str);
+    };
+    keyData.reserve(preprocessedCode.size()+compilerArguments.size()+256ull);
+
+    append(CCache::VERSION);
+    append(contentType);
+    append(stage);
+    append(options.targetSpirvVersion);
+    append(options.debugInfoFlags.value);
+    if (options.spirvOptimizer)
+    {
+        const auto passes = options.spirvOptimizer->getPasses();
+        append(uint64_t(passes.size()));
+        for (const auto pass : passes)
+            append(pass);
+    }
+    else
+        append(~0ull);
+    // the source name only ends up in the SPIR-V with debug info
+    if (options.debugInfoFlags.value!=E_DEBUG_INFO_FLAGS::EDIF_NONE)
+        appendString(options.preprocessorOptions.sourceIdentifier);
+    // already applied to the preprocessed code, but the defines are cheap to hash and make the key self describing
+    append(uint64_t(options.preprocessorOptions.extraDefines.size()));
+    for (const auto& define : options.preprocessorOptions.extraDefines)
+    {
+        appendString(define.identifier);
+        appendString(define.definition);
+    }
+    appendString(compilerArguments);
+    appendString(preprocessedCode);
+
+    return core::XXHash_256(reinterpret_cast<const uint8_t*>(keyData.data()),keyData.size());
+}
+
+auto IShaderCompiler::CCache::findLoaded(const hash_t& key) const -> const SIndexEntry*
+{
+    auto found = std::lower_bound(m_loadedIndex.begin(),m_loadedIndex.end(),key,[](const SIndexEntry& entry, const hash_t& key)->bool{return entry.key<key;});
+    if (found!=m_loadedIndex.end() && found->key==key)
+        return &*found;
+    return nullptr;
+}
+
+core::smart_refctd_ptr<ICPUBuffer> IShaderCompiler::CCache::find(const hash_t& key) const
+{
+    std::shared_lock lock(m_mutex);
+    if (auto found=m_inserted.find(key); found!=m_inserted.end())
+    {
+        m_hits++;
+        // the caller owns the shader it gets, don't let it alias the cache's copy
+        auto retval = core::make_smart_refctd_ptr<ICPUBuffer>(found->second->getSize());
+        memcpy(retval->getPointer(),found->second->getPointer(),retval->getSize());
+        return retval;
+    }
+    if (const auto* entry=findLoaded(key))
+    {
+        m_hits++;
+        auto retval = core::make_smart_refctd_ptr<ICPUBuffer>(entry->size);
+        memcpy(retval->getPointer(),m_loadedBlobs+entry->offset,entry->size);
+        return retval;
+    }
+    m_misses++;
+    return nullptr;
+}
+
+void IShaderCompiler::CCache::insert(const hash_t& key, const ICPUBuffer* spirv)
+{
+    if (!spirv)
+        return;
+    // copy outside of the lock
+    auto copy = core::make_smart_refctd_ptr<ICPUBuffer>(spirv->getSize());
+    memcpy(copy->getPointer(),spirv->getPointer(),copy->getSize());
+
+    std::unique_lock lock(m_mutex);
+    if (findLoaded(key))
+        return;
+    if (m_inserted.emplace(key,std::move(copy)).second)
+        m_insertions++;
+}
+
+size_t IShaderCompiler::CCache::getEntryCount() const
+{
+    std::shared_lock lock(m_mutex);
+    size_t count = m_loadedIndex.size();
+    for (const auto& entry : m_inserted)
+    if (!findLoaded(entry.first))
+        count++;
+    return count;
+}
+
+bool IShaderCompiler::CCache::load(core::smart_refctd_ptr<system::IFile>&& file)
+{
+    if (!file)
+        return false;
+    const size_t fileSize = file->getSize();
+    if (fileSize<sizeof(SHeader))
+        return false;
+
+    core::vector<uint8_t> copy;
+    const auto* data = reinterpret_cast<const uint8_t*>(static_cast<const system::IFile*>(file.get())->getMappedPointer());
+    if (!data)
+    {
+        copy.resize(fileSize);
+        system::IFile::success_t succ;
+        file->read(succ,copy.data(),0,fileSize);
+        if (!succ)
+            return false;
+        data = copy.data();
+        file = nullptr;
+    }
+
+    SHeader header;
+    memcpy(&header,data,sizeof(SHeader));
+    if (header.magic!=Magic || header.version!=VERSION)
+        return false;
+    if (header.entryCount>(fileSize-sizeof(SHeader))/sizeof(SIndexEntry))
+        return false;
+    const std::span<const SIndexEntry> index(reinterpret_cast<const SIndexEntry*>(data+sizeof(SHeader)),header.entryCount);
+    const size_t blobsOffset = sizeof(SHeader)+index.size_bytes();
+    for (const auto& entry : index)
+    if (entry.offset>fileSize-blobsOffset || entry.size>fileSize-blobsOffset-entry.offset)
+        return false;
+    if (!std::is_sorted(index.begin(),index.end(),[](const SIndexEntry& lhs, const SIndexEntry& rhs)->bool{return lhs.key<rhs.key;}))
+        return false;
+
+    std::unique_lock lock(m_mutex);
+    m_loadedFile = std::move(file);
+    m_loadedCopy = std::move(copy);
+    m_loadedIndex = index;
+    m_loadedBlobs = data+blobsOffset;
+    return true;
+}
+
+bool IShaderCompiler::CCache::save(system::IFile* file) const
+{
+    if (!file)
+        return false;
+
+    std::shared_lock lock(m_mutex);
+    // pairs of index entry and pointer to the blob's bytes
+    core::vector<std::pair<SIndexEntry,const void*>> entries;
+    entries.reserve(m_loadedIndex.size()+m_inserted.size());
+    for (const auto& entry : m_loadedIndex)
+        entries.emplace_back(entry,m_loadedBlobs+entry.offset);
+    for (const auto& entry : m_inserted)
+    if (!findLoaded(entry.first))
+        entries.emplace_back(SIndexEntry{entry.first,0ull,entry.second->getSize()},entry.second->getPointer());
+    std::sort(entries.begin(),entries.end(),[](const auto& lhs, const auto& rhs)->bool{return lhs.first.key<rhs.first.key;});
+
+    uint64_t offset = 0ull;
+    for (auto& entry : entries)
+    {
+        entry.first.offset = offset;
+        offset += entry.first.size;
+    }
+
+    system::CBufferedFileWriter writer(file);
+    writer.write(SHeader{Magic,VERSION,entries.size()});
+    for (const auto& entry : entries)
+        writer.write(entry.first);
+    for (const auto& entry : entries)
+        writer.write(entry.second,entry.first.size);
+    return writer.flush();
+}
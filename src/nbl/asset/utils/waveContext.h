@@ -47,7 +47,7 @@ struct load_to_string final
 struct preprocessing_hooks final : public boost::wave::context_policies::default_preprocessing_hooks
 {
     preprocessing_hooks(const IShaderCompiler::SPreprocessorOptions& _preprocessOptions) 
-        : m_includeFinder(_preprocessOptions.includeFinder), m_logger(_preprocessOptions.logger), m_pragmaStage(IShader::ESS_UNKNOWN), m_dxc_compile_flags_override() 
+        : m_includeFinder(_preprocessOptions.includeFinder), m_dependencies(_preprocessOptions.dependencies), m_logger(_preprocessOptions.logger), m_pragmaStage(IShader::ESS_UNKNOWN), m_dxc_compile_flags_override() 
     {
         hash_token_occurences = 0;
     }
@@ -155,6 +155,7 @@ struct preprocessing_hooks final : public boost::wave::context_policies::default
 
 
     const IShaderCompiler::CIncludeFinder* m_includeFinder;
+    core::vector<IShaderCompiler::CIncludeFinder::SDependency>* m_dependencies;
     system::logger_opt_ptr m_logger;
     IShader::E_SHADER_STAGE m_pragmaStage;
     int hash_token_occurences;
@@ -499,6 +500,8 @@ template<> inline bool boost::wave::impl::pp_iterator_functor<nbl::wave::context
             result = includeFinder->getIncludeStandard(ctx.get_current_directory(),file_path);
         else
             result = includeFinder->getIncludeRelative(ctx.get_current_directory(),file_path);
+        if (result && ctx.get_hooks().m_dependencies)
+            ctx.get_hooks().m_dependencies->push_back({ctx.get_current_directory(),file_path,result.absolutePath,result.hash,is_system});
     }
     else {
         ctx.get_hooks().m_logger.log("Pre-processor error: Include finder not assigned, preprocessor will not include file " + file_path, nbl::system::ILogger::ELL_ERROR);
@@ -472,8 +472,9 @@ auto CMitsubaMaterialCompilerFrontend::compileToIRTree(asset::material_compiler:
         *dst = ir_node;
     }
 
-    ir->addRootNode(frontroot);
-    ir->addRootNode(backroot);
+    // identical materials come back as the same trees
+    frontroot = ir->addRootNode(frontroot);
+    backroot = ir->addRootNode(backroot);
 
     return { frontroot, backroot };
 }
@@ -367,7 +367,103 @@ bool CFileArchiveZip::scanCentralDirectoryHeader(size_t& offset)
 }
 #endif
 
+CArchiveLoaderZip::CArchive::~CArchive()
+{
+	// the LRU cache's backing list doesn't destroy leftover elements
+	std::unique_lock lock(m_decompressedCacheMutex);
+	evictDecompressedEntries(0ull);
+}
+
+void CArchiveLoaderZip::CArchive::setDecompressedCacheBudget(const size_t bytes)
+{
+	std::unique_lock lock(m_decompressedCacheMutex);
+	m_decompressedCacheBudget = bytes;
+	evictDecompressedEntries(bytes);
+}
+
+void CArchiveLoaderZip::CArchive::prefetch(const std::span<const path> pathsRelativeToArchive)
+{
+	{
+		std::unique_lock lock(m_decompressedCacheMutex);
+		if (!m_decompressedCacheBudget)
+			return;
+	}
+
+	core::vector<IFileArchive::SFileList::found_t> items;
+	items.reserve(pathsRelativeToArchive.size());
+	for (const auto& p : pathsRelativeToArchive)
+	if (auto item=getItemFromPath(p); item && item->allocatorType==EAT_VIRTUAL_ALLOC)
+		items.push_back(std::move(item));
+	// each decompression is independent, the results only meet under the cache lock
+	std::for_each(core::execution::par,items.begin(),items.end(),[this](const IFileArchive::SFileList::found_t& item)->void
+	{
+		acquireDecompressedEntry(item);
+	});
+}
+
+core::smart_refctd_ptr<IFile> CArchiveLoaderZip::CArchive::getFile_impl(const SFileList::found_t& found, const core::bitflag<IFile::E_CREATE_FLAGS> flags, const std::string_view& password)
+{
+	// compressed entries are always backed by a shared `CDecompressedEntry`, even with the cache off, so the file view's allocator never changes
+	if (found->allocatorType==EAT_VIRTUAL_ALLOC)
+		return CFileArchive::getFile_impl<CDecompressedEntryAllocator>(found,flags);
+	return CFileArchive::getFile_impl(found,flags,password);
+}
+
 CFileArchive::file_buffer_t CArchiveLoaderZip::CArchive::getFileBuffer(const IFileArchive::SFileList::found_t& item)
+{
+	if (item->allocatorType!=EAT_VIRTUAL_ALLOC)
+		return decompressFileBuffer(item);
+
+	auto entry = acquireDecompressedEntry(item);
+	if (!entry)
+		return {nullptr,item->size,nullptr};
+	// this reference is owned by the file view now, `CDecompressedEntryAllocator::dealloc` drops it
+	entry->grab();
+	return {entry->buffer,entry->size,entry.get()};
+}
+
+auto CArchiveLoaderZip::CArchive::acquireDecompressedEntry(const IFileArchive::SFileList::found_t& item) -> core::smart_refctd_ptr<CDecompressedEntry>
+{
+	{
+		std::unique_lock lock(m_decompressedCacheMutex);
+		if (auto found=m_decompressedCache.get(item->ID))
+			return *found;
+	}
+
+	// decompress outside the lock so many entries can be decoded at once
+	const auto fileBuffer = decompressFileBuffer(item);
+	if (!fileBuffer.buffer)
+		return nullptr;
+	auto entry = core::make_smart_refctd_ptr<CDecompressedEntry>(fileBuffer.buffer,fileBuffer.size,item->size);
+
+	std::unique_lock lock(m_decompressedCacheMutex);
+	// someone else might have decoded the same entry in the meantime, keep theirs so all views share one copy
+	if (auto found=m_decompressedCache.get(item->ID))
+		return *found;
+	if (entry->allocationSize<=m_decompressedCacheBudget)
+	{
+		evictDecompressedEntries(m_decompressedCacheBudget-entry->allocationSize);
+		m_decompressedCache.insert(item->ID,core::smart_refctd_ptr(entry));
+		m_decompressedCacheSize += entry->allocationSize;
+	}
+	return entry;
+}
+
+void CArchiveLoaderZip::CArchive::evictDecompressedEntries(const size_t budget)
+{
+	while (m_decompressedCacheSize>budget)
+	{
+		const bool popped = m_decompressedCache.popLeastRecentlyUsed([this](core::smart_refctd_ptr<CDecompressedEntry>& evicted)->void
+		{
+			m_decompressedCacheSize -= evicted->allocationSize;
+			evicted = nullptr;
+		});
+		if (!popped)
+			break;
+	}
+}
+
+CFileArchive::file_buffer_t CArchiveLoaderZip::CArchive::decompressFileBuffer(const IFileArchive::SFileList::found_t& item)
 {
 	const auto& header = m_itemsMetadata[item->ID];
 	// Nabla supports 0, 8, 12, 14, 99
@@ -2,6 +2,9 @@
 #define _NBL_SYSTEM_C_ARCHIVE_LOADER_ZIP_H_INCLUDED_
 
 
+#include "nbl/core/execution.h"
+#include "nbl/core/containers/LRUCache.h"
+
 #include "nbl/system/CFileArchive.h"
 
 
@@ -42,15 +45,63 @@ class CArchiveLoaderZip final : public IArchiveLoader
 					std::shared_ptr<core::vector<IFileArchive::SFileList::SEntry>> _items,
 					core::vector<SZIPFileHeader>&& _itemsMetadata
 				) : CFileArchive(path(_file->getFileName()),std::move(logger),_items),
-					m_file(std::move(_file)), m_itemsMetadata(std::move(_itemsMetadata)), m_password("")
+					m_file(std::move(_file)), m_itemsMetadata(std::move(_itemsMetadata)), m_password(""),
+					m_decompressedCache(core::max<uint32_t>(m_itemsMetadata.size(),2u))
 				{}
+				~CArchive();
+
+				void setDecompressedCacheBudget(const size_t bytes) override;
+				void prefetch(const std::span<const path> pathsRelativeToArchive) override;
 
 			private:
+				// Decompressed entries are shared by the file views and the LRU cache, last one to drop it frees the memory
+				class CDecompressedEntry final : public core::IReferenceCounted
+				{
+					public:
+						inline CDecompressedEntry(void* _buffer, const size_t _size, const size_t _allocationSize) : buffer(_buffer), size(_size), allocationSize(_allocationSize) {}
+
+						void* const buffer;
+						// LZMA can decode to less than the header advertised
+						const size_t size;
+						const size_t allocationSize;
+
+					protected:
+						inline ~CDecompressedEntry()
+						{
+							VirtualMemoryAllocator(nullptr).dealloc(buffer,allocationSize);
+						}
+				};
+				// allocator state is the entry, so the file view just drops its reference
+				class CDecompressedEntryAllocator final : public IFileViewAllocator
+				{
+					public:
+						using IFileViewAllocator::IFileViewAllocator;
+
+						inline void* alloc(size_t size) override {return nullptr;}
+						inline bool dealloc(void* data, size_t size) override
+						{
+							static_cast<CDecompressedEntry*>(m_state)->drop();
+							return true;
+						}
+				};
+				static_assert(sizeof(CInnerArchiveFile<CDecompressedEntryAllocator>)<=sizeof(CInnerArchiveFile<CPlainHeapAllocator>));
+
+				core::smart_refctd_ptr<IFile> getFile_impl(const SFileList::found_t& found, const core::bitflag<IFile::E_CREATE_FLAGS> flags, const std::string_view& password) override;
 				file_buffer_t getFileBuffer(const IFileArchive::SFileList::found_t& item) override;
 
+				file_buffer_t decompressFileBuffer(const IFileArchive::SFileList::found_t& item);
+				core::smart_refctd_ptr<CDecompressedEntry> acquireDecompressedEntry(const IFileArchive::SFileList::found_t& item);
+				// needs `m_decompressedCacheMutex` to be held
+				void evictDecompressedEntries(const size_t budget);
+
 				core::smart_refctd_ptr<IFile> m_file;
 				core::vector<SZIPFileHeader> m_itemsMetadata;
 				const std::string m_password; // TODO password
+
+				std::mutex m_decompressedCacheMutex;
+				core::LRUCache<uint32_t,core::smart_refctd_ptr<CDecompressedEntry>> m_decompressedCache;
+				size_t m_decompressedCacheBudget = 0ull;
+				size_t m_decompressedCacheSize = 0ull;
 		};
 
 		CArchiveLoaderZip(system::logger_opt_smart_ptr&& logger) : IArchiveLoader(std::move(logger)) {}
@@ -3,9 +3,11 @@
 using namespace nbl::system;
 
 #ifdef __unix__ // WTF: can it be `defined(_NBL_PLATFORM_ANDROID_) | defined(_NBL_PLATFORM_LINUX_)` instead?
+#include <errno.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 CFilePOSIX::CFilePOSIX(
 	core::smart_refctd_ptr<ISystem>&& sys,
@@ -13,28 +15,145 @@ CFilePOSIX::CFilePOSIX(
 	const core::bitflag<E_CREATE_FLAGS> _flags,
 	void* const _mappedPtr,
 	const size_t _size,
+	const size_t _mappedSize,
 	const native_file_handle_t _native
 ) : ISystemFile(std::move(sys),std::move(_filename),_flags,_mappedPtr),
-	m_size(_size), m_native(_native)
+	m_size(_size), m_mappedSize(_mappedSize), m_native(_native)
 {
 }
 
 CFilePOSIX::~CFilePOSIX()
 {
 	if (m_mappedPtr)
-		munmap(m_mappedPtr,m_size);
+	{
+		munmap(m_mappedPtr,m_mappedSize);
+		// drop the slack left over from geometric growth
+		if ((getFlags()&ECF_WRITE) && m_mappedSize!=m_size)
+			ftruncate(m_native,m_size);
+	}
 	close(m_native);
 }
 
+size_t CFilePOSIX::getPageSize()
+{
+	static const size_t pageSize = sysconf(_SC_PAGESIZE);
+	return pageSize;
+}
+
+bool CFilePOSIX::syncMapping(size_t offset, size_t size, const int syncFlags)
+{
+	std::unique_lock lock(m_mappingMutex);
+	if (!m_mappedPtr)
+		return false;
+	if (offset>=m_size)
+		return true;
+	size = core::min(size,m_size-offset);
+	// `msync` needs a page aligned address
+	const size_t alignedOffset = offset-offset%getPageSize();
+	return msync(reinterpret_cast<uint8_t*>(m_mappedPtr)+alignedOffset,size+offset-alignedOffset,syncFlags)==0;
+}
+
+bool CFilePOSIX::growMapping(const size_t newSize)
+{
+	std::unique_lock lock(m_mappingMutex);
+	if (!m_mappedPtr || !(getFlags()&ECF_WRITE))
+		return false;
+	if (newSize>m_mappedSize)
+	{
+		const size_t newMappedSize = core::roundUp(core::max(newSize,m_mappedSize*2ull),getPageSize());
+		if (ftruncate(m_native,newMappedSize)!=0)
+			return false;
+		void* const newPtr = mremap(m_mappedPtr,m_mappedSize,newMappedSize,MREMAP_MAYMOVE);
+		if (newPtr==MAP_FAILED)
+		{
+			ftruncate(m_native,m_mappedSize);
+			return false;
+		}
+		m_mappedPtr = newPtr;
+		m_mappedSize = newMappedSize;
+	}
+	core::atomic_fetch_max(&m_size,newSize);
+	return true;
+}
+
+// positional I/O doesn't touch the shared file offset, so many I/O workers can service the same file at once
 size_t CFilePOSIX::asyncRead(void* buffer, size_t offset, size_t sizeToRead)
 {
-	lseek(m_native, offset, SEEK_SET);
-	return ::read(m_native, buffer, sizeToRead);
+	size_t bytesRead = 0ull;
+	while (bytesRead<sizeToRead)
+	{
+		const ssize_t result = ::pread(m_native,reinterpret_cast<uint8_t*>(buffer)+bytesRead,sizeToRead-bytesRead,offset+bytesRead);
+		if (result<0 && errno==EINTR)
+			continue;
+		// EOF or error
+		if (result<=0)
+			break;
+		bytesRead += result;
+	}
+	return bytesRead;
+}
+
+// runs of spans which are adjacent in the file get gathered into a single `preadv`
+size_t CFilePOSIX::asyncReadv(const SReadSpan* spans, size_t count)
+{
+	constexpr size_t MaxIoVecs = 64ull;
+	iovec iov[MaxIoVecs];
+
+	size_t bytesRead = 0ull;
+	for (size_t i=0ull; i<count;)
+	{
+		const size_t runOffset = spans[i].offset;
+		size_t runSize = 0ull;
+		int iovCount = 0;
+		for (; i<count && iovCount<MaxIoVecs && spans[i].offset==runOffset+runSize; i++)
+		{
+			iov[iovCount].iov_base = spans[i].dst;
+			iov[iovCount].iov_len = spans[i].size;
+			iovCount++;
+			runSize += spans[i].size;
+		}
+
+		size_t runRead = 0ull;
+		while (runRead<runSize)
+		{
+			const ssize_t result = ::preadv(m_native,iov,iovCount,runOffset+runRead);
+			if (result<0 && errno==EINTR)
+				continue;
+			if (result<=0)
+				break;
+			runRead += result;
+			// short read, skip over the iovecs already filled and retry the rest
+			size_t consumed = result;
+			int first = 0;
+			while (first<iovCount && consumed>=iov[first].iov_len)
+				consumed -= iov[first++].iov_len;
+			if (first<iovCount)
+			{
+				iov[first].iov_base = reinterpret_cast<uint8_t*>(iov[first].iov_base)+consumed;
+				iov[first].iov_len -= consumed;
+			}
+			std::copy(iov+first,iov+iovCount,iov);
+			iovCount -= first;
+		}
+		// on EOF or error the run comes up short, later runs can still be before the EOF so keep going
+		bytesRead += runRead;
+	}
+	return bytesRead;
 }
 
 size_t CFilePOSIX::asyncWrite(const void* buffer, size_t offset, size_t sizeToWrite)
 {
-	lseek(m_native, offset, SEEK_SET);
-	return ::write(m_native, buffer, sizeToWrite);
+	size_t bytesWritten = 0ull;
+	while (bytesWritten<sizeToWrite)
+	{
+		const ssize_t result = ::pwrite(m_native,reinterpret_cast<const uint8_t*>(buffer)+bytesWritten,sizeToWrite-bytesWritten,offset+bytesWritten);
+		if (result<0 && errno==EINTR)
+			continue;
+		if (result<=0)
+			break;
+		bytesWritten += result;
+	}
+	core::atomic_fetch_max(&m_size,offset+bytesWritten);
+	return bytesWritten;
 }
 #endif
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "nbl/system/ISystemFile.h"
 
+#include <shared_mutex>
+
 namespace nbl::system
 {
 
@@ -17,23 +19,38 @@ class CFilePOSIX : public ISystemFile
 			const core::bitflag<E_CREATE_FLAGS> _flags,
 			void* const _mappedPtr,
 			const size_t _size,
+			const size_t _mappedSize,
 			const native_file_handle_t _native
 		);
 
-		// This is wrong! should re-query every time you call!
-		inline size_t getSize() const override {return m_size;}
+		// Still wrong if someone else modifies the file, but at least tracks our own writes
+		inline size_t getSize() const override {return m_size.load();}
+
+		//
+		static size_t getPageSize();
+
+		// `msync` of the pages overlapping the range, `syncFlags` is `MS_SYNC` for flushes and `MS_INVALIDATE` for invalidations
+		bool syncMapping(size_t offset, size_t size, const int syncFlags);
 
 	protected:
 		~CFilePOSIX();
 
+		// extends the file with `ftruncate` and the mapping with `mremap`, the mapping grows geometrically and gets trimmed on close
+		bool growMapping(const size_t newSize) override;
+		// a grow takes the lock exclusively, so `mremap` can't move the mapping from under a pinned copy
+		inline void pinMapping() const override {m_mappingMutex.lock_shared();}
+		inline void unpinMapping() const override {m_mappingMutex.unlock_shared();}
+
 		//
 		size_t asyncRead(void* buffer, size_t offset, size_t sizeToRead) override;
+		size_t asyncReadv(const SReadSpan* spans, size_t count) override;
 		size_t asyncWrite(const void* buffer, size_t offset, size_t sizeToWrite) override;
 
 	private:
-		void seek(const size_t bytesFromBeginningOfFile);
-
-		const size_t m_size; // this is wrong!
+		std::atomic<size_t> m_size;
+		// can be larger than `m_size` for writable mappings
+		size_t m_mappedSize;
+		mutable std::shared_mutex m_mappingMutex;
 		const native_file_handle_t m_native;
 };
 #endif
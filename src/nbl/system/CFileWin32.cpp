@@ -55,25 +55,37 @@ inline size_t CFileWin32::getSize() const
 	return (size_t(hi)<<32ull)|lo;
 }
 
+bool CFileWin32::flushMapping(size_t offset, size_t size)
+{
+	if (!m_mappedPtr)
+		return false;
+	const size_t fileSize = getSize();
+	if (offset>=fileSize || size==0ull)
+		return true;
+	size = core::min(size,fileSize-offset);
+	// `FlushViewOfFile` only starts the writeback, the file handle flush waits for it (and the metadata) to hit the disk
+	if (!FlushViewOfFile(reinterpret_cast<uint8_t*>(m_mappedPtr)+offset,size))
+		return false;
+	return FlushFileBuffers(m_native)!=FALSE;
+}
+
+// passing the offset via OVERLAPPED on a synchronous handle makes the I/O positional, so many I/O workers can service the same file at once
 size_t CFileWin32::asyncRead(void* buffer, size_t offset, size_t sizeToRead)
 {
-	seek(offset);
-	DWORD numOfBytesRead;
-	ReadFile(m_native, buffer, sizeToRead, &numOfBytesRead, nullptr);
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = LODWORD(offset);
+	overlapped.OffsetHigh = HIDWORD(offset);
+	DWORD numOfBytesRead = 0;
+	ReadFile(m_native, buffer, sizeToRead, &numOfBytesRead, &overlapped);
 	return numOfBytesRead;
 }
 size_t CFileWin32::asyncWrite(const void* buffer, size_t offset, size_t sizeToWrite)
 {
-	seek(offset);
-	DWORD numOfBytesWritten;
-	WriteFile(m_native, buffer, sizeToWrite, &numOfBytesWritten, nullptr);
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = LODWORD(offset);
+	overlapped.OffsetHigh = HIDWORD(offset);
+	DWORD numOfBytesWritten = 0;
+	WriteFile(m_native, buffer, sizeToWrite, &numOfBytesWritten, &overlapped);
 	return numOfBytesWritten;
 }
-
-
-void CFileWin32::seek(size_t position)
-{
-	LONG hiDword = HIDWORD(position);
-	SetFilePointer(m_native,position,&hiDword,FILE_BEGIN);
-}
 #endif
\ No newline at end of file
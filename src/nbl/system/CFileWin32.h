@@ -25,6 +25,9 @@ class CFileWin32 : public ISystemFile
 		//
 		size_t getSize() const override;
 
+		//! Writes the dirty pages of the view in the range back to the file and waits for them to reach the disk
+		bool flushMapping(size_t offset, size_t size);
+
 	protected:
 		~CFileWin32();
 		
@@ -32,8 +35,6 @@ class CFileWin32 : public ISystemFile
 		size_t asyncWrite(const void* buffer, size_t offset, size_t sizeToWrite) override;
 
 	private:
-		void seek(const size_t bytesFromBeginningOfFile);
-
 		HANDLE m_native;
 		HANDLE m_fileMappingObj;
 };
@@ -13,8 +13,8 @@ using namespace nbl::system;
 #include <sys/stat.h>
 #include <fcntl.h>
 
-CSystemAndroid::CSystemAndroid(ANativeActivity* activity, JNIEnv* jni, const path& APKResourcesPath) :
-	ISystemPOSIX(), m_nativeActivity(activity), m_jniEnv(jni)
+CSystemAndroid::CSystemAndroid(ANativeActivity* activity, JNIEnv* jni, const path& APKResourcesPath, const uint32_t ioWorkerCount) :
+	ISystemPOSIX(ioWorkerCount), m_nativeActivity(activity), m_jniEnv(jni)
 {
 	m_cachedArchiveFiles.insert(APKResourcesPath,core::make_smart_refctd_ptr<CAPKResourcesArchive>(
 		path(APKResourcesPath),
@@ -101,4 +101,17 @@ core::smart_refctd_ptr<ISystemFile> CSystemWin32::CCaller::createFile(const std:
     }
     return core::make_smart_refctd_ptr<CFileWin32>(core::smart_refctd_ptr<ISystem>(m_system),path(filename),flags,_mappedPtr,_native,_fileMappingObj);
 }
+
+// all views of a file mapping object are coherent with each other, files from archives are plain memory
+bool CSystemWin32::CCaller::invalidateMapping_impl(IFile* file, size_t offset, size_t size)
+{
+    return true;
+}
+
+bool CSystemWin32::CCaller::flushMapping_impl(IFile* file, size_t offset, size_t size)
+{
+    if (auto* win32File=dynamic_cast<CFileWin32*>(file))
+        return win32File->flushMapping(offset,size);
+    return true;
+}
 #endif
\ No newline at end of file
@@ -14,8 +14,13 @@
 using namespace nbl;
 using namespace nbl::system;
 
-ISystem::ISystem(core::smart_refctd_ptr<ISystem::ICaller>&& caller) : m_dispatcher(std::move(caller))
+ISystem::ISystem(core::smart_refctd_ptr<ISystem::ICaller>&& caller, const uint32_t ioWorkerCount) : m_caller(std::move(caller))
 {
+    const uint32_t workerCount = core::max(ioWorkerCount,1u);
+    m_dispatchers.reserve(workerCount);
+    for (uint32_t i=0u; i<workerCount; i++)
+        m_dispatchers.push_back(std::make_unique<CAsyncQueue>(core::smart_refctd_ptr(m_caller)));
+
     addArchiveLoader(core::make_smart_refctd_ptr<CArchiveLoaderZip>(nullptr));
     addArchiveLoader(core::make_smart_refctd_ptr<CArchiveLoaderTar>(nullptr));
     
@@ -214,7 +219,7 @@ void ISystem::createFile(future_t<core::smart_refctd_ptr<IFile>>& future, std::f
     SRequestParams_CREATE_FILE params;
     strcpy(params.filename,filename.string().c_str());
     params.flags = flags.value;
-    m_dispatcher.request(&future,params);
+    dispatchRequest(&future,params);
 }
 
 core::smart_refctd_ptr<IFileArchive> ISystem::openFileArchive(core::smart_refctd_ptr<IFile>&& file, const std::string_view& password)
@@ -282,6 +287,10 @@ void ISystem::SRequestParams_READ::operator()(core::StorageTrivializer<retval_t>
 {
     retval->construct(file->asyncRead(buffer,offset,size));
 }
+void ISystem::SRequestParams_READV::operator()(core::StorageTrivializer<retval_t>* retval, ICaller* _caller)
+{
+    retval->construct(file->asyncReadv(spans,count));
+}
 void ISystem::SRequestParams_WRITE::operator()(core::StorageTrivializer<retval_t>* retval, ICaller* _caller)
 {
     retval->construct(file->asyncWrite(buffer,offset,size));
@@ -289,8 +298,10 @@ void ISystem::SRequestParams_WRITE::operator()(core::StorageTrivializer<retval_t
 
 bool ISystem::ICaller::invalidateMapping(IFile* file, size_t offset, size_t size)
 {
+    if (!file)
+        return false;
     const auto flags = file->getFlags();
-    if (!file || !(flags&IFile::ECF_MAPPABLE))
+    if (!(flags&IFile::ECF_MAPPABLE))
         return false;
     else if (flags&IFile::ECF_COHERENT)
         return true;
@@ -298,8 +309,10 @@ bool ISystem::ICaller::invalidateMapping(IFile* file, size_t offset, size_t size
 }
 bool ISystem::ICaller::flushMapping(IFile* file, size_t offset, size_t size)
 {
+    if (!file)
+        return false;
     const auto flags = file->getFlags();
-    if (!file || !(flags&IFile::ECF_MAPPABLE))
+    if (!(flags&IFile::ECF_MAPPABLE))
         return false;
     else if (flags&IFile::ECF_COHERENT)
         return true;
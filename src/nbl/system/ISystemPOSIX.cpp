@@ -11,10 +11,12 @@ using namespace nbl::system;
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 core::smart_refctd_ptr<ISystemFile> ISystemPOSIX::CCaller::createFile(const std::filesystem::path& filename, const core::bitflag<IFile::E_CREATE_FLAGS> flags)
 {	
     const bool writeAccess = flags.value&IFile::ECF_WRITE;
+	const bool mappable = flags.value&IFile::ECF_MAPPABLE;
 	int createFlags = O_LARGEFILE|(writeAccess ? O_CREAT:0);
 	switch (flags.value&IFile::ECF_READ_WRITE)
 	{
@@ -22,7 +24,8 @@ core::smart_refctd_ptr<ISystemFile> ISystemPOSIX::CCaller::createFile(const std:
 			createFlags |= O_RDONLY;
 			break;
 		case IFile::ECF_WRITE:
-			createFlags |= O_WRONLY;
+			// `mmap` needs a readable descriptor even for write-only mappings
+			createFlags |= mappable ? O_RDWR:O_WRONLY;
 			break;
 		case IFile::ECF_READ_WRITE:
 			createFlags |= O_RDWR;
@@ -38,7 +41,8 @@ core::smart_refctd_ptr<ISystemFile> ISystemPOSIX::CCaller::createFile(const std:
 	// only create a new file if we're going to be writing
 	if (writeAccess)
 	{
-		_native = creat(name_c_str, S_IRUSR | S_IRGRP | S_IROTH);//open(name_c_str, createFlags, S_IRUSR | S_IRGRP | S_IROTH);
+		// same semantics as `creat` but honouring the access mode
+		_native = open(name_c_str, createFlags|O_TRUNC, S_IRUSR | S_IRGRP | S_IROTH);
 	}
 	else if (std::filesystem::exists(filename))
 	{
@@ -53,7 +57,7 @@ core::smart_refctd_ptr<ISystemFile> ISystemPOSIX::CCaller::createFile(const std:
 	// get size
 	size_t _size;
 	struct stat sb;
-	if (stat(name_c_str,&sb) == -1)
+	if (fstat(_native,&sb) == -1)
 	{
 		close(_native);
 		return nullptr;
@@ -63,10 +67,23 @@ core::smart_refctd_ptr<ISystemFile> ISystemPOSIX::CCaller::createFile(const std:
 
 	// map if needed
 	void* _mappedPtr = nullptr;
-	if (flags.value & IFile::ECF_MAPPABLE)
+	size_t _mappedSize = 0ull;
+	if (mappable)
 	{
+		_mappedSize = _size;
+		// freshly created files are empty and you can't map 0 bytes, so give writable mappings some room to grow into
+		if (writeAccess && _mappedSize==0ull)
+		{
+			_mappedSize = CFilePOSIX::getPageSize();
+			if (ftruncate(_native,_mappedSize)!=0)
+			{
+				close(_native);
+				return nullptr;
+			}
+		}
 		const int mappingFlags = ((flags.value&IFile::ECF_READ) ? PROT_READ:0)|(writeAccess ? PROT_WRITE:0);
-		_mappedPtr = mmap((caddr_t)0, _size, mappingFlags, MAP_PRIVATE, _native, 0);
+		// writes need to reach the file, read-only mappings stay private so nobody else's writes can change our view
+		_mappedPtr = mmap((caddr_t)0, _mappedSize, mappingFlags, writeAccess ? MAP_SHARED:MAP_PRIVATE, _native, 0);
 		if (_mappedPtr==MAP_FAILED)
 		{
 			close(_native);
@@ -74,6 +91,21 @@ core::smart_refctd_ptr<ISystemFile> ISystemPOSIX::CCaller::createFile(const std:
 		}
 	}
 
-	return core::make_smart_refctd_ptr<CFilePOSIX>(core::smart_refctd_ptr<ISystem>(m_system),path(filename),flags,_mappedPtr,_size,_native);
+	return core::make_smart_refctd_ptr<CFilePOSIX>(core::smart_refctd_ptr<ISystem>(m_system),path(filename),flags,_mappedPtr,_size,_mappedSize,_native);
+}
+
+// files from archives are plain memory, there's nothing to synchronize with
+bool ISystemPOSIX::CCaller::invalidateMapping_impl(IFile* file, size_t offset, size_t size)
+{
+	if (auto* posixFile=dynamic_cast<CFilePOSIX*>(file))
+		return posixFile->syncMapping(offset,size,MS_INVALIDATE);
+	return true;
+}
+
+bool ISystemPOSIX::CCaller::flushMapping_impl(IFile* file, size_t offset, size_t size)
+{
+	if (auto* posixFile=dynamic_cast<CFilePOSIX*>(file))
+		return posixFile->syncMapping(offset,size,MS_SYNC);
+	return true;
 }
 #endif
@@ -4,6 +4,10 @@
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <fstream>
+#include <sstream>
+#include <optional>
+#include <numeric>
 
 using namespace nbl;
 using namespace nbl::system;
@@ -43,6 +47,9 @@ public:
 			return false;
 		}
 
+		if (std::find(argv.begin(), argv.end(), "-batch") != argv.end())
+			return compile_batch();
+
 		m_arguments = std::vector<std::string>(argv.begin() + 1, argv.end()-1); // turn argv into vector for convenience
 		std::string file_to_compile = argv.back();
 
@@ -165,6 +172,234 @@ public:
 
 private:
 
+	// One job per non-empty manifest line which doesn't start with '#':
+	//	<input> <output> [extra DXC arguments for this job only, e.g. -T cs_6_7 -DFOO=1]
+	// Relative paths are relative to the manifest, arguments given to nsc itself apply to every job.
+	struct BatchJob
+	{
+		std::string input;
+		std::vector<std::string> arguments;
+		std::vector<std::string> outputs;
+		core::vector<IShaderCompiler::CIncludeFinder::SDependency> dependencies = {};
+		bool success = false;
+	};
+
+	// nsc [shared arguments] -batch <manifest> [-depfile <file>] [-cache <file>]
+	bool compile_batch()
+	{
+		m_arguments = std::vector<std::string>(argv.begin() + 1, argv.end());
+		auto extractFlagValue = [&](const std::string_view flag) -> std::optional<std::string>
+		{
+			auto found = std::find(m_arguments.begin(), m_arguments.end(), flag);
+			if (found == m_arguments.end())
+				return std::nullopt;
+			if (found + 1 == m_arguments.end())
+			{
+				m_logger->log("Incorrect arguments. Expecting a filename after %s.", ILogger::ELL_ERROR, flag.data());
+				return std::string();
+			}
+			std::string value = *(found + 1);
+			m_arguments.erase(found, found + 2);
+			return value;
+		};
+		const auto manifestPath = extractFlagValue("-batch");
+		const auto depfilePath = extractFlagValue("-depfile");
+		const auto cachePath = extractFlagValue("-cache");
+		if (manifestPath->empty() || (depfilePath && depfilePath->empty()) || (cachePath && cachePath->empty()))
+			return false;
+
+		auto builtin_flag_pos = std::find(m_arguments.begin(), m_arguments.end(), "-no-nbl-builtins");
+		if (builtin_flag_pos != m_arguments.end()) {
+			m_logger->log("Unmounting builtins.");
+			m_system->unmountBuiltins();
+			no_nbl_builtins = true;
+			m_arguments.erase(builtin_flag_pos);
+		}
+#ifndef NBL_EMBED_BUILTIN_RESOURCES
+		if (!no_nbl_builtins) {
+			m_system->unmountBuiltins();
+			no_nbl_builtins = true;
+			m_logger->log("nsc.exe was compiled with builtin resources disabled. Force enabling -no-nbl-builtins.", ILogger::ELL_WARNING);
+		}
+#endif
+
+		// parse the manifest, jobs compiling the same file with the same arguments get merged
+		std::vector<BatchJob> jobs;
+		{
+			std::ifstream manifest(*manifestPath);
+			if (!manifest)
+			{
+				m_logger->log("Could not open batch manifest %s", ILogger::ELL_ERROR, manifestPath->c_str());
+				return false;
+			}
+			const auto manifestDir = std::filesystem::absolute(*manifestPath).parent_path();
+			std::unordered_map<std::string, size_t> jobIndex;
+			std::string line;
+			for (uint32_t lineNumber = 1u; std::getline(manifest, line); lineNumber++)
+			{
+				std::istringstream tokens(line);
+				std::vector<std::string> words;
+				for (std::string word; tokens >> word;)
+					words.push_back(std::move(word));
+				if (words.empty() || words.front().front() == '#')
+					continue;
+				if (words.size() < 2)
+				{
+					m_logger->log("Batch manifest line %d: expecting an input and an output filename.", ILogger::ELL_ERROR, lineNumber);
+					return false;
+				}
+
+				BatchJob job;
+				job.input = std::filesystem::weakly_canonical(manifestDir / words[0]).string();
+				job.arguments = m_arguments;
+				job.arguments.insert(job.arguments.end(), words.begin() + 2, words.end());
+				if (std::find(job.arguments.begin(), job.arguments.end(), "-E") == job.arguments.end())
+				{
+					job.arguments.push_back("-E");
+					job.arguments.push_back("main");
+				}
+				const std::string output = (manifestDir / words[1]).lexically_normal().string();
+
+				std::string key = job.input;
+				for (const auto& argument : job.arguments)
+					key += '\0' + argument;
+				auto found = jobIndex.emplace(std::move(key), jobs.size());
+				if (found.second)
+					jobs.push_back(std::move(job));
+				jobs[found.first->second].outputs.push_back(output);
+			}
+		}
+		m_logger->log("Batch has " + std::to_string(jobs.size()) + " unique jobs.");
+
+		// loading goes through the asset manager which we don't share across threads
+		std::vector<smart_refctd_ptr<const ICPUShader>> shaders(jobs.size());
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			shaders[i] = open_shader_file(jobs[i].input);
+			if (shaders[i] && shaders[i]->getContentType() != IShader::E_CONTENT_TYPE::ECT_HLSL)
+			{
+				m_logger->log("Error. %s content is not HLSL.", ILogger::ELL_ERROR, jobs[i].input.c_str());
+				shaders[i] = nullptr;
+			}
+		}
+
+		auto cache = make_smart_refctd_ptr<IShaderCompiler::CCache>();
+		if (cachePath && m_system->exists(*cachePath, IFileBase::ECF_READ))
+		{
+			ISystem::future_t<smart_refctd_ptr<IFile>> future;
+			m_system->createFile(future, *cachePath, IFileBase::ECF_READ);
+			smart_refctd_ptr<IFile> file;
+			if (auto lock = future.acquire())
+				lock.move_into(file);
+			if (!cache->load(std::move(file)))
+				m_logger->log("Could not load the shader cache %s, starting with an empty one.", ILogger::ELL_WARNING, cachePath->c_str());
+		}
+
+		// one compiler and include finder shared by all the workers
+		auto hlslcompiler = make_smart_refctd_ptr<CHLSLCompiler>(smart_refctd_ptr(m_system));
+		auto includeFinder = make_smart_refctd_ptr<IShaderCompiler::CIncludeFinder>(smart_refctd_ptr(m_system));
+		std::vector<size_t> jobIDs(jobs.size());
+		std::iota(jobIDs.begin(), jobIDs.end(), 0ull);
+		std::for_each(core::execution::par, jobIDs.begin(), jobIDs.end(), [&](const size_t i) -> void
+		{
+			auto& job = jobs[i];
+			if (!shaders[i])
+				return;
+
+			CHLSLCompiler::SOptions options = {};
+			options.stage = shaders[i]->getStage();
+			options.preprocessorOptions.sourceIdentifier = job.input;
+			options.preprocessorOptions.logger = m_logger.get();
+			options.preprocessorOptions.includeFinder = includeFinder.get();
+			options.preprocessorOptions.dependencies = &job.dependencies;
+			options.dxcOptions = std::span<const std::string>(job.arguments);
+			options.cache = cache.get();
+
+			auto compiled = hlslcompiler->compileToSPIRV((const char*)shaders[i]->getContent()->getPointer(), options);
+			if (!compiled)
+			{
+				m_logger->log("Shader compilation of %s failed.", ILogger::ELL_ERROR, job.input.c_str());
+				return;
+			}
+			job.success = true;
+			for (const auto& output : job.outputs)
+			{
+				std::fstream output_file(output, std::ios::out | std::ios::binary);
+				output_file.write((const char*)compiled->getContent()->getPointer(), compiled->getContent()->getSize());
+				job.success = job.success && bool(output_file);
+			}
+		});
+
+		const auto stats = cache->getStatistics();
+		m_logger->log("Shader cache: " + std::to_string(stats.hits) + " hits, " + std::to_string(stats.misses) + " misses.");
+		if (cachePath && stats.insertions)
+		{
+			// written next to the old one and then moved over it, the old one might still be mapped
+			const system::path tmpPath = *cachePath + ".tmp";
+			bool saved = false;
+			{
+				ISystem::future_t<smart_refctd_ptr<IFile>> future;
+				m_system->createFile(future, tmpPath, IFileBase::ECF_WRITE);
+				if (auto file = future.acquire(); file)
+					saved = cache->save(file->get());
+			}
+			cache = nullptr;
+			// a failed save must not replace a good cache with a truncated one
+			std::error_code ec;
+			if (saved)
+				std::filesystem::rename(tmpPath, *cachePath, ec);
+			else
+			{
+				m_logger->log("Could not save the shader cache to %s.", ILogger::ELL_WARNING, tmpPath.string().c_str());
+				std::filesystem::remove(tmpPath, ec);
+			}
+		}
+
+		if (depfilePath)
+		{
+			// Makefile syntax, one rule per unique job with all its outputs as targets, builtins are left out as they aren't files
+			auto escape = [](std::string path) -> std::string
+			{
+				std::replace(path.begin(), path.end(), '\\', '/');
+				std::string escaped;
+				for (const char c : path)
+				{
+					if (c == ' ' || c == '#')
+						escaped += '\\';
+					else if (c == '$')
+						escaped += '$';
+					escaped += c;
+				}
+				return escaped;
+			};
+			std::ofstream depfile(*depfilePath);
+			for (auto& job : jobs)
+			{
+				if (!job.success)
+					continue;
+				for (const auto& output : job.outputs)
+					depfile << escape(output) << ' ';
+				depfile << ": " << escape(job.input);
+				std::vector<system::path> dependencies;
+				for (const auto& dependency : job.dependencies)
+					dependencies.push_back(dependency.absolutePath);
+				std::sort(dependencies.begin(), dependencies.end());
+				dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+				for (const auto& dependency : dependencies)
+				if (std::filesystem::exists(dependency))
+					depfile << " \\\n  " << escape(dependency.string());
+				depfile << "\n";
+			}
+		}
+
+		const bool success = std::all_of(jobs.begin(), jobs.end(), [](const BatchJob& job) { return job.success; });
+		if (success)
+			m_logger->log("Batch compilation successful.");
+		else
+			m_logger->log("Batch compilation failed.", ILogger::ELL_ERROR);
+		return success;
+	}
+
 	core::smart_refctd_ptr<ICPUShader> compile_shader(const ICPUShader* shader, std::string_view sourceIdentifier) {
 		smart_refctd_ptr<CHLSLCompiler> hlslcompiler = make_smart_refctd_ptr<CHLSLCompiler>(smart_refctd_ptr(m_system));
 
@@ -182,7 +417,8 @@ private:
 
 	core::smart_refctd_ptr<const ICPUShader> open_shader_file(std::string filepath) {
 
-		m_assetMgr = make_smart_refctd_ptr<asset::IAssetManager>(smart_refctd_ptr(m_system));
+		if (!m_assetMgr)
+			m_assetMgr = make_smart_refctd_ptr<asset::IAssetManager>(smart_refctd_ptr(m_system));
 
 		IAssetLoader::SAssetLoadParams lp = {};
 		lp.logger = m_logger.get();
@@ -57,14 +57,21 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    std::vector<char> buffer(fileSize);
-    if (!file.read(buffer.data(), fileSize)) {
-        std::cerr << "Failed to read file: " << filePath << std::endl;
-        return 1;
+    // stream the file through a fixed size window instead of holding all of it in memory, the hasher consumes whole blocks straight from it
+    constexpr size_t ChunkSize = 0x1ull<<22u;
+    std::vector<char> buffer(std::min<size_t>(ChunkSize,fileSize));
+    nbl::core::XXHash256 hasher(fileSize);
+    for (size_t offset=0; offset<fileSize;)
+    {
+        const size_t chunk = std::min<size_t>(buffer.size(),fileSize-offset);
+        if (!file.read(buffer.data(), chunk)) {
+            std::cerr << "Failed to read file: " << filePath << std::endl;
+            return 1;
+        }
+        hasher.update(buffer.data(), chunk);
+        offset += chunk;
     }
-
-    std::array<uint64_t, 4> hash = {};
-    nbl::core::XXHash_256(buffer.data(), fileSize, hash.data());
+    const auto hash = hasher.finalize();
 
     printf("{\"u64hash\": [%s,%s,%s,%s]}", std::to_string(hash[0]).c_str(), std::to_string(hash[1]).c_str(), std::to_string(hash[2]).c_str(), std::to_string(hash[3]).c_str());
 